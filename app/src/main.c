@@ -6,75 +6,448 @@
 #include <zephyr/kernel.h>
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#ifdef CONFIG_CONTROL_MAP_ZBUS
+#include <zephyr/zbus/zbus.h>
+#endif
 
-#include <app/drivers/blink.h>
+#include <app/lib/boot_profile.h>
+#include <app/lib/control_map.h>
+#include <app/lib/device_residency.h>
+#include <app/lib/edge_detect.h>
+#include <app/lib/event_log.h>
+#include <app/lib/job_sched.h>
+#include <app/lib/monitor.h>
+#include <app/lib/retained_ring.h>
+#include <app/lib/telemetry.h>
 
 #include <app_version.h>
 
 LOG_MODULE_REGISTER(main, CONFIG_APP_LOG_LEVEL);
 
-#define BLINK_PERIOD_MS_STEP 100U
-#define BLINK_PERIOD_MS_MAX  1000U
+#define NUM_PAIRS CONTROL_MAP_NUM_PAIRS
 
-int main(void)
+#define CONTROL_PERIOD_MS     100U
+#define CONTROL_SLACK_MS      10U
+#define SCHED_STATS_PERIOD_MS 10000U
+
+/* Mount point of the littlefs partition holding the event log */
+#define EVENT_LOG_DIR "/lfs"
+
+/* Telemetry statistics sources */
+#define TELEMETRY_SOURCE_JOB_SCHED 0U
+
+/* Proximity level of every pair, bit n for pair n */
+static edge_detect_word_t levels[EDGE_DETECT_WORDS(NUM_PAIRS)];
+
+static void level_set(size_t pair, int32_t val)
 {
-	int ret;
-	unsigned int period_ms = BLINK_PERIOD_MS_MAX;
-	const struct device *sensor, *blink;
-	struct sensor_value last_val = { 0 }, val;
+	edge_detect_word_t bit = (edge_detect_word_t)1U
+				 << (pair % EDGE_DETECT_WORD_BITS);
 
-	printk("Zephyr Example Application %s\n", APP_VERSION_STRING);
+	if (val == 1) {
+		levels[pair / EDGE_DETECT_WORD_BITS] |= bit;
+	} else {
+		levels[pair / EDGE_DETECT_WORD_BITS] &= ~bit;
+	}
+}
 
-	sensor = DEVICE_DT_GET(DT_NODELABEL(example_sensor));
-	if (!device_is_ready(sensor)) {
-		LOG_ERR("Sensor not ready");
-		return 0;
+#ifdef CONFIG_RETAINED_RING
+static void retained_ring_report(const struct retained_ring_entry *entry,
+				 void *user_data)
+{
+	static const char *const type_names[] = {
+		[RETAINED_RING_EDGE] = "edge",
+		[RETAINED_RING_PERIOD] = "period",
+		[RETAINED_RING_LATENCY] = "latency",
+	};
+
+	ARG_UNUSED(user_data);
+
+	LOG_INF("#%u %u ms: %s %u %d", entry->seq, entry->uptime_ms,
+		type_names[entry->type], entry->id, entry->value);
+}
+#endif /* CONFIG_RETAINED_RING */
+
+#ifdef CONFIG_DEVICE_RESIDENCY
+static void device_residency_report(const struct device *dev,
+				    const struct device_residency_stats *stats,
+				    void *user_data)
+{
+	uint64_t total_us = stats->active_us + stats->suspended_us;
+
+	ARG_UNUSED(user_data);
+
+	LOG_INF("%s: active %u%% of %u s, %u resumes", dev->name,
+		(unsigned int)((total_us > 0U) ?
+			       (stats->active_us * 100U / total_us) : 0U),
+		(unsigned int)(total_us / USEC_PER_SEC), stats->resumes);
+}
+#endif /* CONFIG_DEVICE_RESIDENCY */
+
+#ifdef CONFIG_MONITOR
+static void monitor_report(const void *record, size_t len, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	LOG_HEXDUMP_INF(record, len, "monitor");
+}
+#endif /* CONFIG_MONITOR */
+
+#ifdef CONFIG_CONTROL_MAP_ZBUS
+static void sample_logger_cb(const struct zbus_channel *chan)
+{
+	/* Runs in the publishing thread, reads the channel copy in place */
+	const struct control_map_sample *sample = zbus_chan_const_msg(chan);
+
+	for (size_t w = 0U; w < ARRAY_SIZE(sample->levels); w++) {
+		if ((sample->rising[w] | sample->falling[w]) != 0U) {
+			LOG_DBG("%lld ms: pairs %zu+ levels 0x%llx",
+				(long long)sample->uptime_ms,
+				w * EDGE_DETECT_WORD_BITS,
+				(unsigned long long)sample->levels[w]);
+		}
 	}
+}
 
-	blink = DEVICE_DT_GET(DT_NODELABEL(blink_led));
-	if (!device_is_ready(blink)) {
-		LOG_ERR("Blink LED not ready");
-		return 0;
+ZBUS_LISTENER_DEFINE(sample_logger, sample_logger_cb);
+ZBUS_CHAN_ADD_OBS(control_map_sample_chan, sample_logger, 0);
+#endif /* CONFIG_CONTROL_MAP_ZBUS */
+
+#ifdef CONFIG_EXAMPLE_SENSOR_TRIGGER
+static ATOMIC_DEFINE(trigger_levels, NUM_PAIRS);
+/* Pairs that went near since the loop last ran, so short pulses are kept */
+static ATOMIC_DEFINE(trigger_near, NUM_PAIRS);
+static K_SEM_DEFINE(trigger_sem, 0, 1);
+
+static void sensor_trigger_handler(const struct device *dev,
+				   const struct sensor_trigger *trig)
+{
+	struct sensor_value val;
+	int ret;
+
+	ARG_UNUSED(trig);
+
+	ret = sensor_sample_fetch(dev);
+	if (ret == 0) {
+		ret = sensor_channel_get(dev, SENSOR_CHAN_PROX, &val);
 	}
 
-	ret = blink_off(blink);
 	if (ret < 0) {
-		LOG_ERR("Could not turn off LED (%d)", ret);
-		return 0;
+		LOG_ERR("Could not get sample (%d)", ret);
+		return;
 	}
 
-	printk("Use the sensor to change LED blinking period\n");
+	/* A sensor may drive several pairs */
+	for (size_t i = 0U; i < NUM_PAIRS; i++) {
+		if (control_map_pairs[i].sensor != dev) {
+			continue;
+		}
 
-	while (1) {
-		ret = sensor_sample_fetch(sensor);
-		if (ret < 0) {
-			LOG_ERR("Could not fetch sample (%d)", ret);
-			return 0;
+		atomic_set_bit_to(trigger_levels, i, val.val1 == 1);
+		if (val.val1 == 1) {
+			atomic_set_bit(trigger_near, i);
 		}
+	}
+
+	k_sem_give(&trigger_sem);
+}
+
+static int sensors_trigger_set(void)
+{
+	static const struct sensor_trigger trig = {
+		.type = SENSOR_TRIG_NEAR_FAR,
+		.chan = SENSOR_CHAN_PROX,
+	};
+	int ret;
 
-		ret = sensor_channel_get(sensor, SENSOR_CHAN_PROX, &val);
+	for (size_t i = 0U; i < NUM_PAIRS; i++) {
+		ret = sensor_trigger_set(control_map_pairs[i].sensor, &trig,
+					 sensor_trigger_handler);
 		if (ret < 0) {
-			LOG_ERR("Could not get sample (%d)", ret);
-			return 0;
+			return ret;
 		}
+	}
+
+	return 0;
+}
+
+static void control_loop(void)
+{
+	while (1) {
+		/* Woken up by sensor edges only */
+		k_sem_take(&trigger_sem, K_FOREVER);
 
-		if ((last_val.val1 == 0) && (val.val1 == 1)) {
-			if (period_ms == 0U) {
-				period_ms = BLINK_PERIOD_MS_MAX;
-			} else {
-				period_ms -= BLINK_PERIOD_MS_STEP;
+		/* Replay near levels first, in case the pair is far again */
+		for (size_t i = 0U; i < NUM_PAIRS; i++) {
+			if (atomic_test_and_clear_bit(trigger_near, i)) {
+				level_set(i, 1);
 			}
+		}
+		(void)control_map_update(levels);
 
-			printk("Proximity detected, setting LED period to %u ms\n",
-			       period_ms);
-			blink_set_period_ms(blink, period_ms);
+		for (size_t i = 0U; i < NUM_PAIRS; i++) {
+			level_set(i, atomic_test_bit(trigger_levels, i) ? 1 : 0);
 		}
+		(void)control_map_update(levels);
+
+		boot_profile_mark(BOOT_PROFILE_FIRST_SAMPLE);
+	}
+}
+#else
+#ifdef CONFIG_EXAMPLE_SENSOR_ASYNC
+#define SENSOR_IODEV_DEFINE(id, sensor_node, led_node, step, max)              \
+	SENSOR_DT_READ_IODEV(UTIL_CAT(sensor_iodev_, id), sensor_node,         \
+			     {SENSOR_CHAN_PROX, 0});
+
+#define SENSOR_IODEV_REF(id, sensor_node, led_node, step, max)                 \
+	&UTIL_CAT(sensor_iodev_, id)
 
-		last_val = val;
+CONTROL_MAP_FOREACH_PAIR_SEP(SENSOR_IODEV_DEFINE, ())
 
-		k_sleep(K_MSEC(100));
+static struct rtio_iodev *const sensor_iodevs[NUM_PAIRS] = {
+	CONTROL_MAP_FOREACH_PAIR_SEP(SENSOR_IODEV_REF, (,))
+};
+
+RTIO_DEFINE_WITH_MEMPOOL(sensor_ctx, NUM_PAIRS, NUM_PAIRS, NUM_PAIRS, 16,
+			 sizeof(void *));
+
+static ATOMIC_DEFINE(read_pending, NUM_PAIRS);
+
+static int sensor_read_decode(size_t pair, uint8_t *buf, uint32_t buf_len)
+{
+	const struct sensor_chan_spec prox_chan = {SENSOR_CHAN_PROX, 0};
+	const struct sensor_decoder_api *decoder;
+	struct sensor_byte_data data;
+	uint32_t fit = 0U;
+	int ret;
+
+	ret = sensor_get_decoder(control_map_pairs[pair].sensor, &decoder);
+	if (ret == 0) {
+		ret = decoder->decode(buf, prox_chan, &fit, 1, &data);
 	}
 
+	if (ret < 0) {
+		return ret;
+	}
+
+	level_set(pair, data.readings[0].is_near);
+
 	return 0;
 }
 
+static int sensors_read(void)
+{
+	struct rtio_cqe *cqe;
+	uint32_t buf_len;
+	uint8_t *buf;
+	int completed = 0;
+	int ret;
+
+	for (size_t i = 0U; i < NUM_PAIRS; i++) {
+		if (atomic_test_and_set_bit(read_pending, i)) {
+			continue;
+		}
+
+		ret = sensor_read_async_mempool(sensor_iodevs[i], &sensor_ctx,
+						(void *)i);
+		if (ret < 0) {
+			atomic_clear_bit(read_pending, i);
+			return ret;
+		}
+	}
+
+	/* Keep the control loop running while reads are in flight */
+	while ((cqe = rtio_cqe_consume(&sensor_ctx)) != NULL) {
+		size_t pair = (size_t)cqe->userdata;
+
+		atomic_clear_bit(read_pending, pair);
+
+		ret = cqe->result;
+		if (ret == 0) {
+			ret = rtio_cqe_get_mempool_buffer(&sensor_ctx, cqe,
+							  &buf, &buf_len);
+		}
+
+		rtio_cqe_release(&sensor_ctx, cqe);
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = sensor_read_decode(pair, buf, buf_len);
+
+		rtio_release_buffer(&sensor_ctx, buf, buf_len);
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		completed++;
+	}
+
+	return completed;
+}
+#else
+static int sensors_read(void)
+{
+	struct sensor_value val;
+	int ret;
+
+	for (size_t i = 0U; i < NUM_PAIRS; i++) {
+		const struct device *dev = control_map_pairs[i].sensor;
+
+		ret = sensor_sample_fetch(dev);
+		if (ret == 0) {
+			ret = sensor_channel_get(dev, SENSOR_CHAN_PROX, &val);
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		level_set(i, val.val1);
+	}
+
+	return NUM_PAIRS;
+}
+#endif /* CONFIG_EXAMPLE_SENSOR_ASYNC */
+
+/* Longest control job run since the last statistics, in microseconds */
+static uint32_t loop_latency_max_us;
+
+static void control_job_handler(struct job_sched_job *job)
+{
+	uint32_t start = k_cycle_get_32();
+	uint32_t latency_us;
+	int ret;
+
+	ret = sensors_read();
+	if (ret < 0) {
+		LOG_ERR("Could not get sample (%d)", ret);
+		(void)job_sched_remove(job);
+		return;
+	}
+
+	if (ret > 0) {
+		boot_profile_mark(BOOT_PROFILE_FIRST_SAMPLE);
+
+		(void)control_map_update(levels);
+	}
+
+	latency_us = k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+	loop_latency_max_us = MAX(loop_latency_max_us, latency_us);
+}
+
+static struct job_sched_job control_job = JOB_SCHED_JOB_INITIALIZER(
+	control_job_handler, CONTROL_PERIOD_MS, CONTROL_SLACK_MS);
+
+static void sched_stats_job_handler(struct job_sched_job *job)
+{
+	static struct job_sched_stats last;
+	struct job_sched_stats stats;
+	int32_t rates[2];
+
+	ARG_UNUSED(job);
+
+	job_sched_stats_get(&stats);
+
+	/* Wakeups and job runs per second */
+	rates[0] = (stats.wakeups - last.wakeups) * 1000U / SCHED_STATS_PERIOD_MS;
+	rates[1] = (stats.runs - last.runs) * 1000U / SCHED_STATS_PERIOD_MS;
+
+	last = stats;
+
+#ifdef CONFIG_RETAINED_RING
+	retained_ring_record(RETAINED_RING_LATENCY, 0U,
+			     (int32_t)loop_latency_max_us);
+#endif
+	loop_latency_max_us = 0U;
+
+#ifdef CONFIG_TELEMETRY
+	(void)telemetry_stats(TELEMETRY_SOURCE_JOB_SCHED, rates,
+			      ARRAY_SIZE(rates));
+#endif
+
+#ifdef CONFIG_DEVICE_RESIDENCY
+	device_residency_foreach(device_residency_report, NULL);
+#endif
+
+	LOG_DBG("%d wakeups/s, %d job runs/s", rates[0], rates[1]);
+}
+
+/* Not time critical, shares the wakeups of the control job */
+static struct job_sched_job sched_stats_job = JOB_SCHED_JOB_INITIALIZER(
+	sched_stats_job_handler, SCHED_STATS_PERIOD_MS, CONTROL_PERIOD_MS);
+
+static void control_loop(void)
+{
+	(void)job_sched_add(&control_job, 0U);
+
+	if (IS_ENABLED(CONFIG_APP_LOG_LEVEL_DBG) ||
+	    IS_ENABLED(CONFIG_TELEMETRY) ||
+	    IS_ENABLED(CONFIG_RETAINED_RING) ||
+	    IS_ENABLED(CONFIG_DEVICE_RESIDENCY)) {
+		(void)job_sched_add(&sched_stats_job, SCHED_STATS_PERIOD_MS);
+	}
+
+	/* Periodic work of the application runs from the main thread */
+	job_sched_run();
+}
+#endif /* CONFIG_EXAMPLE_SENSOR_TRIGGER */
+
+int main(void)
+{
+	int ret;
+
+	boot_profile_mark(BOOT_PROFILE_MAIN);
+
+	printk("Zephyr Example Application %s\n", APP_VERSION_STRING);
+
+#ifdef CONFIG_RETAINED_RING
+	/* Read back before the new entries overwrite the old ones */
+	ret = retained_ring_init();
+	if (ret > 0) {
+		LOG_INF("Warm boot %u, %d entries from before the reset:",
+			retained_ring_boots(), ret);
+		(void)retained_ring_foreach_previous(retained_ring_report, NULL);
+	}
+#endif
+
+	ret = control_map_init();
+	if (ret < 0) {
+		LOG_ERR("Could not set up sensor to LED pairs (%d)", ret);
+		return 0;
+	}
+
+	printk("Use the sensors to change LED blinking periods\n");
+
+#ifdef CONFIG_EVENT_LOG
+	/* Not fatal, the application runs without history */
+	ret = event_log_init(EVENT_LOG_DIR);
+	if (ret < 0) {
+		LOG_ERR("Could not initialize event log (%d)", ret);
+	}
+#endif
+
+#ifdef CONFIG_MONITOR
+	ret = monitor_start(monitor_report, NULL);
+	if (ret < 0) {
+		LOG_ERR("Could not start monitor (%d)", ret);
+		return 0;
+	}
+#endif
+
+#ifdef CONFIG_EXAMPLE_SENSOR_TRIGGER
+	ret = sensors_trigger_set();
+	if (ret < 0) {
+		LOG_ERR("Could not set trigger (%d)", ret);
+		return 0;
+	}
+#endif
+
+	/* A single loop serves every pair */
+	control_loop();
+
+	return 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/sys/util.h>
+
+#include <app/drivers/blink.h>
+
+/* Number of batched entries copied to the kernel stack at a time */
+#define BLINK_MANY_CHUNK 8U
+
+static inline int z_vrfy_blink_set_period_ms(const struct device *dev,
+					     unsigned int period_ms)
+{
+	K_OOPS(K_SYSCALL_DRIVER_BLINK(dev, set_period_ms));
+
+	return z_impl_blink_set_period_ms(dev, period_ms);
+}
+#include <syscalls/blink_set_period_ms_mrsh.c>
+
+static inline int z_vrfy_blink_set_period_ms_many(const struct device **devs,
+						  const unsigned int *periods,
+						  size_t n)
+{
+	const struct device *kdevs[BLINK_MANY_CHUNK];
+	unsigned int kperiods[BLINK_MANY_CHUNK];
+	size_t chunk;
+	int ret;
+
+	/* Reject the whole batch up front rather than failing half-way */
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_READ(devs, n, sizeof(*devs)));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_READ(periods, n, sizeof(*periods)));
+
+	for (size_t i = 0; i < n; i += BLINK_MANY_CHUNK) {
+		chunk = MIN(n - i, BLINK_MANY_CHUNK);
+
+		K_OOPS(k_usermode_from_copy(kdevs, &devs[i],
+					    chunk * sizeof(*kdevs)));
+
+		for (size_t j = 0; j < chunk; j++) {
+			K_OOPS(K_SYSCALL_DRIVER_BLINK(kdevs[j], set_period_ms));
+		}
+	}
+
+	for (size_t i = 0; i < n; i += BLINK_MANY_CHUNK) {
+		chunk = MIN(n - i, BLINK_MANY_CHUNK);
+
+		/*
+		 * Copied and checked again, as user threads can swap entries
+		 * after the first pass. Only such a thread can fail here.
+		 */
+		K_OOPS(k_usermode_from_copy(kdevs, &devs[i],
+					    chunk * sizeof(*kdevs)));
+		K_OOPS(k_usermode_from_copy(kperiods, &periods[i],
+					    chunk * sizeof(*kperiods)));
+
+		for (size_t j = 0; j < chunk; j++) {
+			K_OOPS(K_SYSCALL_DRIVER_BLINK(kdevs[j], set_period_ms));
+		}
+
+		ret = z_impl_blink_set_period_ms_many(kdevs, kperiods, chunk);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+#include <syscalls/blink_set_period_ms_many_mrsh.c>
@@ -11,47 +11,199 @@
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/pm/device_runtime.h>
 
 #include <app/drivers/blink.h>
+#include <app/drivers/blink/gpio_led.h>
+#include <app/drivers/gpio_fast.h>
+#include <app/lib/boot_profile.h>
+#include <app/lib/device_residency.h>
+#include <app/tracing.h>
 
 LOG_MODULE_REGISTER(blink_gpio_led, CONFIG_BLINK_LOG_LEVEL);
 
+#ifdef CONFIG_BLINK_GPIO_LED_COUNTERS
+STATS_NAME_START(blink_gpio_led_counters)
+STATS_NAME(blink_gpio_led_counters, timer_expiries)
+STATS_NAME(blink_gpio_led_counters, toggle_failures)
+STATS_NAME(blink_gpio_led_counters, period_changes)
+STATS_NAME_END(blink_gpio_led_counters);
+#endif /* CONFIG_BLINK_GPIO_LED_COUNTERS */
+
 struct blink_gpio_led_data {
 	struct k_timer timer;
+	struct gpio_fast_pin led_fast;
+	/* Current period, 0 when off: the device is only resumed while not 0 */
+	atomic_t period_ms;
+#ifdef CONFIG_BLINK_GPIO_LED_COUNTERS
+	STATS_SECT_DECL(blink_gpio_led_counters) counters;
+#endif
+#ifdef CONFIG_DEVICE_RESIDENCY
+	struct device_residency residency;
+#endif
 };
 
 struct blink_gpio_led_config {
 	struct gpio_dt_spec led;
+	uintptr_t led_port_addr;
 	unsigned int period_ms;
 };
 
+#if defined(CONFIG_BLINK_GPIO_LED_SINGLE_INSTANCE) &&                          \
+	(DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) == 1)
+/*
+ * Only one instance exists: resolve its config and data at compile time so
+ * that the LED port and pin fold into constants on the hot paths.
+ */
+static struct blink_gpio_led_data data0;
+static const struct blink_gpio_led_config config0;
+
+#define BLINK_GPIO_LED_CONFIG(dev)       (&config0)
+#define BLINK_GPIO_LED_DATA(dev)         (&data0)
+#define BLINK_GPIO_LED_TIMER_CONFIG(tmr) (&config0)
+#define BLINK_GPIO_LED_TIMER_DATA(tmr)   (&data0)
+#else
+#define BLINK_GPIO_LED_CONFIG(dev)                                             \
+	((const struct blink_gpio_led_config *)(dev)->config)
+#define BLINK_GPIO_LED_DATA(dev) ((struct blink_gpio_led_data *)(dev)->data)
+#define BLINK_GPIO_LED_TIMER_CONFIG(tmr)                                       \
+	BLINK_GPIO_LED_CONFIG(                                                 \
+		(const struct device *)k_timer_user_data_get(tmr))
+#define BLINK_GPIO_LED_TIMER_DATA(tmr)                                         \
+	CONTAINER_OF(tmr, struct blink_gpio_led_data, timer)
+#endif
+
 static void blink_gpio_led_on_timer_expire(struct k_timer *timer)
 {
-	const struct device *dev = k_timer_user_data_get(timer);
-	const struct blink_gpio_led_config *config = dev->config;
+	const struct blink_gpio_led_config *config =
+		BLINK_GPIO_LED_TIMER_CONFIG(timer);
+	struct blink_gpio_led_data *data = BLINK_GPIO_LED_TIMER_DATA(timer);
 	int ret;
 
+	APP_TRACE_BLINK_TOGGLE(k_timer_user_data_get(timer));
+
+#ifdef CONFIG_BLINK_GPIO_LED_COUNTERS
+	STATS_INC(data->counters, timer_expiries);
+#endif
+
+	if (gpio_fast_pin_enabled(&data->led_fast)) {
+		gpio_fast_pin_toggle(&data->led_fast);
+		return;
+	}
+
 	ret = gpio_pin_toggle_dt(&config->led);
 	if (ret < 0) {
+#ifdef CONFIG_BLINK_GPIO_LED_COUNTERS
+		STATS_INC(data->counters, toggle_failures);
+#endif
 		LOG_ERR("Could not toggle LED GPIO (%d)", ret);
 	}
 }
 
+#ifdef CONFIG_BLINK_GPIO_LED_TEST_HOOKS
+void blink_gpio_led_timer_expire(const struct device *dev)
+{
+	struct blink_gpio_led_data *data = BLINK_GPIO_LED_DATA(dev);
+
+	blink_gpio_led_on_timer_expire(&data->timer);
+}
+#endif
+
 static int blink_gpio_led_set_period_ms(const struct device *dev,
 					unsigned int period_ms)
 {
-	const struct blink_gpio_led_config *config = dev->config;
-	struct blink_gpio_led_data *data = dev->data;
+	const struct blink_gpio_led_config *config = BLINK_GPIO_LED_CONFIG(dev);
+	struct blink_gpio_led_data *data = BLINK_GPIO_LED_DATA(dev);
+	unsigned int previous;
+	int ret;
+
+	previous = (unsigned int)atomic_set(&data->period_ms, period_ms);
+
+	/* Already off, the LED pin may be suspended and disconnected */
+	if ((previous == 0) && (period_ms == 0)) {
+		return 0;
+	}
 
 	if (period_ms == 0) {
 		k_timer_stop(&data->timer);
-		return gpio_pin_set_dt(&config->led, 0);
+		ret = gpio_pin_set_dt(&config->led, 0);
+
+		if (previous > 0) {
+			/* Suspends the device, releasing the LED pin */
+			(void)pm_device_runtime_put(dev);
+		}
+	} else {
+		ret = 0;
+
+		if (previous == 0) {
+			ret = pm_device_runtime_get(dev);
+			if (ret < 0) {
+				atomic_clear(&data->period_ms);
+				return ret;
+			}
+		}
+
+		k_timer_start(&data->timer, K_MSEC(period_ms),
+			      K_MSEC(period_ms));
 	}
 
-	k_timer_start(&data->timer, K_MSEC(period_ms), K_MSEC(period_ms));
+#ifdef CONFIG_BLINK_GPIO_LED_COUNTERS
+	if (ret == 0) {
+		STATS_INC(data->counters, period_changes);
+	}
+#endif
+
+	return ret;
+}
+
+#ifdef CONFIG_PM_DEVICE
+static int blink_gpio_led_pm_action(const struct device *dev,
+				    enum pm_device_action action)
+{
+	const struct blink_gpio_led_config *config = BLINK_GPIO_LED_CONFIG(dev);
+	struct blink_gpio_led_data *data = BLINK_GPIO_LED_DATA(dev);
+	unsigned int period_ms;
+	int ret;
+
+	switch (action) {
+	case PM_DEVICE_ACTION_SUSPEND:
+		k_timer_stop(&data->timer);
+
+		ret = gpio_pin_configure_dt(&config->led, GPIO_DISCONNECTED);
+		if (ret == -ENOTSUP) {
+			/* Left driven low by controllers that can not disconnect */
+			ret = gpio_pin_configure_dt(&config->led,
+						    GPIO_OUTPUT_INACTIVE);
+		}
+		break;
+	case PM_DEVICE_ACTION_RESUME:
+		ret = gpio_pin_configure_dt(&config->led, GPIO_OUTPUT_INACTIVE);
+
+		/* Still blinking after a system suspend */
+		period_ms = (unsigned int)atomic_get(&data->period_ms);
+		if ((ret == 0) && (period_ms > 0)) {
+			k_timer_start(&data->timer, K_MSEC(period_ms),
+				      K_MSEC(period_ms));
+		}
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	if (ret < 0) {
+		LOG_ERR("Could not configure LED GPIO (%d)", ret);
+		return ret;
+	}
+
+#ifdef CONFIG_DEVICE_RESIDENCY
+	device_residency_set(&data->residency,
+			     action == PM_DEVICE_ACTION_RESUME);
+#endif
 
 	return 0;
 }
+#endif /* CONFIG_PM_DEVICE */
 
 static DEVICE_API(blink, blink_gpio_led_api) = {
 	.set_period_ms = &blink_gpio_led_set_period_ms,
@@ -59,10 +211,12 @@ static DEVICE_API(blink, blink_gpio_led_api) = {
 
 static int blink_gpio_led_init(const struct device *dev)
 {
-	const struct blink_gpio_led_config *config = dev->config;
-	struct blink_gpio_led_data *data = dev->data;
+	const struct blink_gpio_led_config *config = BLINK_GPIO_LED_CONFIG(dev);
+	struct blink_gpio_led_data *data = BLINK_GPIO_LED_DATA(dev);
 	int ret;
 
+	boot_profile_mark(BOOT_PROFILE_BLINK_INIT);
+
 	if (!gpio_is_ready_dt(&config->led)) {
 		LOG_ERR("LED GPIO not ready");
 		return -ENODEV;
@@ -74,14 +228,51 @@ static int blink_gpio_led_init(const struct device *dev)
 		return ret;
 	}
 
+	(void)gpio_fast_pin_init(&data->led_fast, config->led_port_addr,
+				 &config->led);
+
+#ifdef CONFIG_BLINK_GPIO_LED_COUNTERS
+	ret = stats_init_and_reg(&data->counters.s_hdr, STATS_SIZE_32,
+				 (sizeof(data->counters) -
+				  sizeof(struct stats_hdr)) / sizeof(uint32_t),
+				 STATS_NAME_INIT_PARMS(blink_gpio_led_counters),
+				 dev->name);
+	if (ret < 0) {
+		LOG_ERR("Could not register counters (%d)", ret);
+		return ret;
+	}
+#endif
+
 	k_timer_init(&data->timer, blink_gpio_led_on_timer_expire, NULL);
 	k_timer_user_data_set(&data->timer, (void *)dev);
 
+#ifdef CONFIG_DEVICE_RESIDENCY
+	device_residency_init(&data->residency, dev, true);
+#endif
+
+#ifdef CONFIG_PM_DEVICE_RUNTIME
+	/* Suspended until blinking starts */
+	ret = pm_device_runtime_enable(dev);
+	if (ret < 0) {
+		LOG_ERR("Could not enable runtime PM (%d)", ret);
+		return ret;
+	}
+#endif
+
 	if (config->period_ms > 0) {
+		atomic_set(&data->period_ms, config->period_ms);
+
+		ret = pm_device_runtime_get(dev);
+		if (ret < 0) {
+			return ret;
+		}
+
 		k_timer_start(&data->timer, K_MSEC(config->period_ms),
 			      K_MSEC(config->period_ms));
 	}
 
+	boot_profile_mark(BOOT_PROFILE_BLINK_READY);
+
 	return 0;
 }
 
@@ -90,10 +281,14 @@ static int blink_gpio_led_init(const struct device *dev)
                                                                                \
 	static const struct blink_gpio_led_config config##inst = {             \
 	    .led = GPIO_DT_SPEC_INST_GET(inst, led_gpios),                     \
+	    .led_port_addr = GPIO_FAST_DT_INST_PORT_ADDR(inst, led_gpios),     \
 	    .period_ms = DT_INST_PROP_OR(inst, blink_period_ms, 0U),           \
 	};                                                                     \
                                                                                \
-	DEVICE_DT_INST_DEFINE(inst, blink_gpio_led_init, NULL, &data##inst,    \
+	PM_DEVICE_DT_INST_DEFINE(inst, blink_gpio_led_pm_action);              \
+                                                                               \
+	DEVICE_DT_INST_DEFINE(inst, blink_gpio_led_init,                       \
+			      PM_DEVICE_DT_INST_GET(inst), &data##inst,        \
 			      &config##inst, POST_KERNEL,                      \
 			      CONFIG_BLINK_INIT_PRIORITY,                      \
 			      &blink_gpio_led_api);
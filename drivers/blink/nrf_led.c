@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT nordic_nrf_blink_led
+
+#include <zephyr/device.h>
+
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <soc.h>
+#include <hal/nrf_timer.h>
+#include <helpers/nrfx_gppi.h>
+#include <nrfx_gpiote.h>
+
+#include <app/drivers/blink.h>
+#include <app/lib/boot_profile.h>
+
+LOG_MODULE_REGISTER(blink_nrf_led, CONFIG_BLINK_LOG_LEVEL);
+
+/* 16 MHz / 2^4, which also selects the lower power 1 MHz TIMER clock */
+#define TIMER_PRESCALER    4U
+#define TIMER_TICKS_PER_MS 1000U
+#define PERIOD_MS_MAX      (UINT32_MAX / TIMER_TICKS_PER_MS)
+
+struct blink_nrf_led_data {
+	uint8_t ppi_ch;
+};
+
+struct blink_nrf_led_config {
+	nrfx_gpiote_t gpiote;
+	NRF_TIMER_Type *timer;
+	/* Absolute pin number, port included */
+	uint32_t pin;
+	bool active_low;
+	unsigned int period_ms;
+};
+
+static int blink_nrf_led_set_period_ms(const struct device *dev,
+				       unsigned int period_ms)
+{
+	const struct blink_nrf_led_config *config = dev->config;
+
+	if (period_ms > PERIOD_MS_MAX) {
+		return -EINVAL;
+	}
+
+	nrf_timer_task_trigger(config->timer, NRF_TIMER_TASK_STOP);
+	nrf_timer_task_trigger(config->timer, NRF_TIMER_TASK_CLEAR);
+
+	if (period_ms == 0) {
+		/* Stopped at any level, driven back to inactive */
+		if (config->active_low) {
+			nrfx_gpiote_set_task_trigger(&config->gpiote,
+						     config->pin);
+		} else {
+			nrfx_gpiote_clr_task_trigger(&config->gpiote,
+						     config->pin);
+		}
+
+		return 0;
+	}
+
+	/* Each compare toggles the LED and clears the TIMER */
+	nrf_timer_cc_set(config->timer, NRF_TIMER_CC_CHANNEL0,
+			 period_ms * TIMER_TICKS_PER_MS);
+	nrf_timer_task_trigger(config->timer, NRF_TIMER_TASK_START);
+
+	return 0;
+}
+
+static DEVICE_API(blink, blink_nrf_led_api) = {
+	.set_period_ms = &blink_nrf_led_set_period_ms,
+};
+
+static int blink_nrf_led_init(const struct device *dev)
+{
+	const struct blink_nrf_led_config *config = dev->config;
+	struct blink_nrf_led_data *data = dev->data;
+	const nrfx_gpiote_output_config_t output_config =
+		NRFX_GPIOTE_DEFAULT_OUTPUT_CONFIG;
+	nrfx_gpiote_task_config_t task_config = {
+		.polarity = NRF_GPIOTE_POLARITY_TOGGLE,
+		.init_val = config->active_low ? NRF_GPIOTE_INITIAL_VALUE_HIGH
+					       : NRF_GPIOTE_INITIAL_VALUE_LOW,
+	};
+	nrfx_err_t err;
+
+	boot_profile_mark(BOOT_PROFILE_BLINK_INIT);
+
+	err = nrfx_gpiote_channel_alloc(&config->gpiote, &task_config.task_ch);
+	if (err != NRFX_SUCCESS) {
+		LOG_ERR("Could not allocate GPIOTE channel");
+		return -ENOMEM;
+	}
+
+	err = nrfx_gpiote_output_configure(&config->gpiote, config->pin,
+					   &output_config, &task_config);
+	if (err != NRFX_SUCCESS) {
+		LOG_ERR("Could not configure LED pin");
+		return -EIO;
+	}
+
+	nrfx_gpiote_out_task_enable(&config->gpiote, config->pin);
+
+	err = nrfx_gppi_channel_alloc(&data->ppi_ch);
+	if (err != NRFX_SUCCESS) {
+		LOG_ERR("Could not allocate PPI channel");
+		return -ENOMEM;
+	}
+
+	/* No interrupt: the CPU is not involved once the TIMER runs */
+	nrf_timer_int_disable(config->timer, ~0U);
+	nrf_timer_mode_set(config->timer, NRF_TIMER_MODE_TIMER);
+	nrf_timer_bit_width_set(config->timer, NRF_TIMER_BIT_WIDTH_32);
+	nrf_timer_prescaler_set(config->timer, TIMER_PRESCALER);
+	nrf_timer_shorts_enable(config->timer,
+				NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK);
+
+	nrfx_gppi_channel_endpoints_setup(
+		data->ppi_ch,
+		nrf_timer_event_address_get(config->timer,
+					    NRF_TIMER_EVENT_COMPARE0),
+		nrfx_gpiote_out_task_address_get(&config->gpiote, config->pin));
+	nrfx_gppi_channels_enable(BIT(data->ppi_ch));
+
+	if (config->period_ms > 0) {
+		(void)blink_nrf_led_set_period_ms(dev, config->period_ms);
+	}
+
+	boot_profile_mark(BOOT_PROFILE_BLINK_READY);
+
+	return 0;
+}
+
+#define BLINK_NRF_LED_DEFINE(inst)                                             \
+	BUILD_ASSERT(DT_INST_PROP_OR(inst, blink_period_ms, 0U) <=             \
+		     PERIOD_MS_MAX,                                            \
+		     "blink-period-ms too large");                             \
+                                                                               \
+	static struct blink_nrf_led_data data##inst;                           \
+                                                                               \
+	static const struct blink_nrf_led_config config##inst = {              \
+	    .gpiote = NRFX_GPIOTE_INSTANCE(                                    \
+		NRF_DT_GPIOTE_INST(DT_DRV_INST(inst), led_gpios)),             \
+	    .timer = (NRF_TIMER_Type *)DT_REG_ADDR(                            \
+		DT_INST_PHANDLE(inst, timer)),                                 \
+	    .pin = NRF_DT_GPIOS_TO_PSEL(DT_DRV_INST(inst), led_gpios),         \
+	    .active_low =                                                      \
+		(DT_INST_GPIO_FLAGS(inst, led_gpios) & GPIO_ACTIVE_LOW) != 0,  \
+	    .period_ms = DT_INST_PROP_OR(inst, blink_period_ms, 0U),           \
+	};                                                                     \
+                                                                               \
+	DEVICE_DT_INST_DEFINE(inst, blink_nrf_led_init, NULL, &data##inst,     \
+			      &config##inst, POST_KERNEL,                      \
+			      CONFIG_BLINK_INIT_PRIORITY,                      \
+			      &blink_nrf_led_api);
+
+DT_INST_FOREACH_STATUS_OKAY(BLINK_NRF_LED_DEFINE)
@@ -8,25 +8,75 @@
 #include <zephyr/device.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/sensor.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/pm/device_runtime.h>
+
+#include <app/drivers/sensor/example_sensor.h>
+#include <app/lib/boot_profile.h>
+#include <app/tracing.h>
+
+#include "example_sensor.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(example_sensor, CONFIG_SENSOR_LOG_LEVEL);
 
-struct example_sensor_data {
-	int state;
-};
+#if defined(CONFIG_EXAMPLE_SENSOR_SINGLE_INSTANCE) &&			       \
+	(DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) == 1)
+/*
+ * Only one instance exists: resolve its config and data at compile time so
+ * that the input port and pin fold into constants on the hot paths.
+ */
+static struct example_sensor_data example_sensor_data_0;
+static const struct example_sensor_config example_sensor_config_0;
 
-struct example_sensor_config {
-	struct gpio_dt_spec input;
-};
+#define EXAMPLE_SENSOR_CONFIG(dev) (&example_sensor_config_0)
+#define EXAMPLE_SENSOR_DATA(dev)   (&example_sensor_data_0)
+#else
+#define EXAMPLE_SENSOR_CONFIG(dev)					       \
+	((const struct example_sensor_config *)(dev)->config)
+#define EXAMPLE_SENSOR_DATA(dev) ((struct example_sensor_data *)(dev)->data)
+#endif
 
 static int example_sensor_sample_fetch(const struct device *dev,
 				      enum sensor_channel chan)
 {
-	const struct example_sensor_config *config = dev->config;
-	struct example_sensor_data *data = dev->data;
+	const struct example_sensor_config *config = EXAMPLE_SENSOR_CONFIG(dev);
+	struct example_sensor_data *data = EXAMPLE_SENSOR_DATA(dev);
+	int ret;
 
-	data->state = gpio_pin_get_dt(&config->input);
+	APP_TRACE_SENSOR_FETCH_START(dev);
+
+	/* Resumes the input for this read when no trigger holds it */
+	ret = pm_device_runtime_get(dev);
+	if (ret == 0) {
+		if (gpio_fast_pin_enabled(&data->input_fast)) {
+			ret = gpio_fast_pin_get(&data->input_fast);
+		} else {
+			ret = gpio_pin_get_dt(&config->input);
+		}
+
+		(void)pm_device_runtime_put(dev);
+	}
+
+	APP_TRACE_SENSOR_FETCH_END(dev, ret);
+
+#ifdef CONFIG_EXAMPLE_SENSOR_COUNTERS
+	STATS_INC(data->counters, fetches);
+	if (ret < 0) {
+		STATS_INC(data->counters, fetch_errors);
+	}
+#endif
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	data->state = ret;
+
+#ifdef CONFIG_EXAMPLE_SENSOR_STATS
+	/* Catches edges on inputs without interrupt support */
+	example_sensor_stats_update(data, data->state);
+#endif
 
 	return 0;
 }
@@ -35,7 +85,13 @@ static int example_sensor_channel_get(const struct device *dev,
 				     enum sensor_channel chan,
 				     struct sensor_value *val)
 {
-	struct example_sensor_data *data = dev->data;
+	struct example_sensor_data *data = EXAMPLE_SENSOR_DATA(dev);
+
+#ifdef CONFIG_EXAMPLE_SENSOR_STATS
+	if (chan >= (enum sensor_channel)EXAMPLE_SENSOR_CHAN_ACTIVE_TIME) {
+		return example_sensor_stats_channel_get(data, chan, val);
+	}
+#endif
 
 	if (chan != SENSOR_CHAN_PROX) {
 		return -ENOTSUP;
@@ -49,14 +105,92 @@ static int example_sensor_channel_get(const struct device *dev,
 static DEVICE_API(sensor, example_sensor_api) = {
 	.sample_fetch = &example_sensor_sample_fetch,
 	.channel_get = &example_sensor_channel_get,
+#ifdef CONFIG_EXAMPLE_SENSOR_STATS
+	.attr_set = &example_sensor_attr_set,
+#endif
+#ifdef CONFIG_EXAMPLE_SENSOR_TRIGGER
+	.trigger_set = &example_sensor_trigger_set,
+#endif
+#ifdef CONFIG_EXAMPLE_SENSOR_ASYNC
+	.submit = &example_sensor_submit,
+	.get_decoder = &example_sensor_get_decoder,
+#endif
 };
 
-static int example_sensor_init(const struct device *dev)
+#ifdef CONFIG_PM_DEVICE
+static int example_sensor_pm_action(const struct device *dev,
+				    enum pm_device_action action)
 {
-	const struct example_sensor_config *config = dev->config;
+	const struct example_sensor_config *config = EXAMPLE_SENSOR_CONFIG(dev);
+	struct example_sensor_data *data = EXAMPLE_SENSOR_DATA(dev);
+	int ret;
+
+	switch (action) {
+	case PM_DEVICE_ACTION_SUSPEND:
+#ifdef CONFIG_EXAMPLE_SENSOR_INTERRUPT
+		(void)gpio_pin_interrupt_configure_dt(&config->input,
+						      GPIO_INT_DISABLE);
+#endif
+		/* Releases the input pull-up, if any */
+		ret = gpio_pin_configure_dt(&config->input, GPIO_DISCONNECTED);
+		if (ret == -ENOTSUP) {
+			/* Left as an input by controllers that can not
+			 * disconnect
+			 */
+			ret = 0;
+		}
+		break;
+	case PM_DEVICE_ACTION_RESUME:
+		ret = gpio_pin_configure_dt(&config->input, GPIO_INPUT);
+		if ((ret == 0) && (config->settle_us > 0U)) {
+			/* Lets the pull-up raise the line before any read or
+			 * edge detection
+			 */
+			k_busy_wait(config->settle_us);
+		}
+#ifdef CONFIG_EXAMPLE_SENSOR_INTERRUPT
+		if (ret == 0) {
+			ret = example_sensor_resume_interrupt(dev);
+		}
+#endif
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	if (ret < 0) {
+		LOG_ERR("Could not configure input GPIO (%d)", ret);
+		return ret;
+	}
+
+#ifdef CONFIG_DEVICE_RESIDENCY
+	device_residency_set(&data->residency,
+			     action == PM_DEVICE_ACTION_RESUME);
+#else
+	ARG_UNUSED(data);
+#endif
 
+	return 0;
+}
+#endif /* CONFIG_PM_DEVICE */
+
+#ifdef CONFIG_EXAMPLE_SENSOR_COUNTERS
+STATS_NAME_START(example_sensor_counters)
+STATS_NAME(example_sensor_counters, fetches)
+STATS_NAME(example_sensor_counters, fetch_errors)
+STATS_NAME(example_sensor_counters, edges)
+STATS_NAME(example_sensor_counters, edges_dropped)
+STATS_NAME_END(example_sensor_counters);
+#endif /* CONFIG_EXAMPLE_SENSOR_COUNTERS */
+
+static int example_sensor_init(const struct device *dev)
+{
+	const struct example_sensor_config *config = EXAMPLE_SENSOR_CONFIG(dev);
+	struct example_sensor_data *data = EXAMPLE_SENSOR_DATA(dev);
 	int ret;
 
+	boot_profile_mark(BOOT_PROFILE_SENSOR_INIT);
+
 	if (!device_is_ready(config->input.port)) {
 		LOG_ERR("Input GPIO not ready");
 		return -ENODEV;
@@ -68,17 +202,98 @@ static int example_sensor_init(const struct device *dev)
 		return ret;
 	}
 
+	(void)gpio_fast_pin_init(&data->input_fast, config->input_port_addr,
+				 &config->input);
+
+#ifdef CONFIG_EXAMPLE_SENSOR_STATS
+	example_sensor_stats_init(data, gpio_pin_get_dt(&config->input));
+#endif
+
+#ifdef CONFIG_EXAMPLE_SENSOR_COUNTERS
+	ret = stats_init_and_reg(&data->counters.s_hdr, STATS_SIZE_32,
+				 (sizeof(data->counters) -
+				  sizeof(struct stats_hdr)) / sizeof(uint32_t),
+				 STATS_NAME_INIT_PARMS(example_sensor_counters),
+				 dev->name);
+	if (ret < 0) {
+		LOG_ERR("Could not register counters (%d)", ret);
+		return ret;
+	}
+#endif
+
+#ifdef CONFIG_EXAMPLE_SENSOR_INTERRUPT
+	ret = example_sensor_init_interrupt(dev);
+	if (ret < 0) {
+		return ret;
+	}
+#endif
+
+#ifdef CONFIG_DEVICE_RESIDENCY
+	device_residency_init(&data->residency, dev, true);
+#endif
+
+#ifdef CONFIG_PM_DEVICE_RUNTIME
+	/* Suspended until a fetch, a read or a trigger needs the input */
+	ret = pm_device_runtime_enable(dev);
+	if (ret < 0) {
+		LOG_ERR("Could not enable runtime PM (%d)", ret);
+		return ret;
+	}
+
+#if defined(CONFIG_EXAMPLE_SENSOR_STATS) ||				       \
+	defined(CONFIG_EXAMPLE_SENSOR_INPUT) ||				       \
+	defined(CONFIG_EXAMPLE_SENSOR_COUNTERS)
+	/* Statistics, input events and counters need every edge */
+	ret = pm_device_runtime_get(dev);
+	if (ret < 0) {
+		return ret;
+	}
+#endif
+#endif /* CONFIG_PM_DEVICE_RUNTIME */
+
+	boot_profile_mark(BOOT_PROFILE_SENSOR_READY);
+
 	return 0;
 }
 
+#define EXAMPLE_SENSOR_INPUT_ON_BUS(i)					       \
+	(DT_ON_BUS(DT_INST_GPIO_CTLR(i, input_gpios), i2c) ||		       \
+	 DT_ON_BUS(DT_INST_GPIO_CTLR(i, input_gpios), spi))
+
+/* Only inputs pulled up by the GPIO controller need to settle */
+#define EXAMPLE_SENSOR_SETTLE_US(i)					       \
+	(((DT_INST_GPIO_FLAGS(i, input_gpios) & GPIO_PULL_UP) != 0) ?	       \
+		 DT_INST_PROP(i, input_settle_us) : 0)
+
+/* Only pins detected with the port SENSE mechanism share a callback */
+#define EXAMPLE_SENSOR_PORT_SENSE_CHECK(i)				       \
+	BUILD_ASSERT((DT_PROP_OR(DT_INST_GPIO_CTLR(i, input_gpios),	       \
+				 sense_edge_mask, 0) &			       \
+		      BIT(DT_INST_GPIO_PIN(i, input_gpios))) != 0,	       \
+		     "Input pin not in the sense-edge-mask of its port");
+
 #define EXAMPLE_SENSOR_INIT(i)						       \
+	IF_ENABLED(CONFIG_EXAMPLE_SENSOR_PORT_SENSE,			       \
+		   (EXAMPLE_SENSOR_PORT_SENSE_CHECK(i)))		       \
+									       \
 	static struct example_sensor_data example_sensor_data_##i;	       \
 									       \
 	static const struct example_sensor_config example_sensor_config_##i = {\
 		.input = GPIO_DT_SPEC_INST_GET(i, input_gpios),		       \
+		.input_port_addr =					       \
+			GPIO_FAST_DT_INST_PORT_ADDR(i, input_gpios),	       \
+		.on_bus = EXAMPLE_SENSOR_INPUT_ON_BUS(i),		       \
+		.settle_us = EXAMPLE_SENSOR_SETTLE_US(i),		       \
+		IF_ENABLED(CONFIG_EXAMPLE_SENSOR_INPUT, (		       \
+		.input_code = DT_INST_PROP_OR(i, zephyr_code, -1),	       \
+		.input_coalesce_ms = DT_INST_PROP(i, input_coalesce_ms),      \
+		))							       \
 	};								       \
 									       \
-	DEVICE_DT_INST_DEFINE(i, example_sensor_init, NULL,		       \
+	PM_DEVICE_DT_INST_DEFINE(i, example_sensor_pm_action);		       \
+									       \
+	DEVICE_DT_INST_DEFINE(i, example_sensor_init,			       \
+			      PM_DEVICE_DT_INST_GET(i),			       \
 			      &example_sensor_data_##i,			       \
 			      &example_sensor_config_##i, POST_KERNEL,	       \
 			      CONFIG_SENSOR_INIT_PRIORITY, &example_sensor_api);
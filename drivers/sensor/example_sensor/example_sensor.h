@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_DRIVERS_SENSOR_EXAMPLE_SENSOR_H_
+#define ZEPHYR_DRIVERS_SENSOR_EXAMPLE_SENSOR_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+
+#include <app/drivers/gpio_fast.h>
+#include <app/drivers/sensor/example_sensor.h>
+#include <app/lib/device_residency.h>
+
+#ifdef CONFIG_EXAMPLE_SENSOR_STATS
+/** Edge statistics, all times in system ticks. */
+struct example_sensor_stats {
+	struct k_spinlock lock;
+	int state;
+	uint32_t edges;
+	int64_t start;
+	int64_t last_edge;
+	int64_t active;
+	int64_t pulse_min;
+	int64_t pulse_max;
+};
+#endif /* CONFIG_EXAMPLE_SENSOR_STATS */
+
+#ifdef CONFIG_EXAMPLE_SENSOR_INPUT
+/** Input event state, times in system ticks. */
+struct example_sensor_input {
+	struct k_spinlock lock;
+	/* Last level seen on the input */
+	int level;
+	/* Last level reported as an input event */
+	int reported;
+	int64_t last_report;
+	/* Reports the final level at the end of a coalescing window */
+	struct k_work_delayable work;
+};
+#endif /* CONFIG_EXAMPLE_SENSOR_INPUT */
+
+struct example_sensor_data {
+	int state;
+	struct gpio_fast_pin input_fast;
+#ifdef CONFIG_EXAMPLE_SENSOR_STATS
+	struct example_sensor_stats stats;
+#endif
+#ifdef CONFIG_EXAMPLE_SENSOR_INPUT
+	struct example_sensor_input input;
+#endif
+#ifdef CONFIG_EXAMPLE_SENSOR_COUNTERS
+	STATS_SECT_DECL(example_sensor_counters) counters;
+	/* Level seen by the previous input interrupt */
+	int last_level;
+#endif
+#ifdef CONFIG_DEVICE_RESIDENCY
+	struct device_residency residency;
+#endif
+#ifdef CONFIG_EXAMPLE_SENSOR_INTERRUPT
+	const struct device *dev;
+#ifdef CONFIG_EXAMPLE_SENSOR_PORT_SENSE
+	/* Node in the list of instances sharing the input port */
+	sys_snode_t port_node;
+#else
+	struct gpio_callback gpio_cb;
+#endif
+#endif
+#ifdef CONFIG_EXAMPLE_SENSOR_TRIGGER
+	sensor_trigger_handler_t handler;
+	const struct sensor_trigger *trigger;
+#if defined(CONFIG_EXAMPLE_SENSOR_STATS) ||                                    \
+	defined(CONFIG_EXAMPLE_SENSOR_INPUT) ||                                \
+	defined(CONFIG_EXAMPLE_SENSOR_COUNTERS)
+	/* Result of enabling the input interrupt, which stays enabled */
+	int interrupt_ret;
+#endif
+#if defined(CONFIG_EXAMPLE_SENSOR_TRIGGER_OWN_THREAD)
+	K_KERNEL_STACK_MEMBER(thread_stack,
+			      CONFIG_EXAMPLE_SENSOR_THREAD_STACK_SIZE);
+	struct k_thread thread;
+	struct k_sem gpio_sem;
+#elif defined(CONFIG_EXAMPLE_SENSOR_TRIGGER_GLOBAL_THREAD)
+	struct k_work work;
+#endif
+#endif /* CONFIG_EXAMPLE_SENSOR_TRIGGER */
+};
+
+struct example_sensor_config {
+	struct gpio_dt_spec input;
+	uintptr_t input_port_addr;
+	/** Input is provided by a GPIO expander on an I2C or SPI bus. */
+	bool on_bus;
+	/** Time for the pulled-up input to settle after resume, in us. */
+	uint16_t settle_us;
+#ifdef CONFIG_EXAMPLE_SENSOR_INPUT
+	/** Input event code, or -1 if the instance reports no input events. */
+	int32_t input_code;
+	/** Minimum time between two input events, in milliseconds. */
+	uint32_t input_coalesce_ms;
+#endif
+};
+
+/** Raw sample produced by the asynchronous read path. */
+struct example_sensor_encoded_data {
+	uint64_t timestamp_ns;
+	int8_t state;
+};
+
+#ifdef CONFIG_EXAMPLE_SENSOR_TRIGGER
+int example_sensor_trigger_set(const struct device *dev,
+			       const struct sensor_trigger *trig,
+			       sensor_trigger_handler_t handler);
+#endif /* CONFIG_EXAMPLE_SENSOR_TRIGGER */
+
+#ifdef CONFIG_EXAMPLE_SENSOR_INTERRUPT
+int example_sensor_init_interrupt(const struct device *dev);
+
+int example_sensor_resume_interrupt(const struct device *dev);
+#endif /* CONFIG_EXAMPLE_SENSOR_INTERRUPT */
+
+#ifdef CONFIG_EXAMPLE_SENSOR_STATS
+void example_sensor_stats_init(struct example_sensor_data *data, int state);
+
+void example_sensor_stats_update(struct example_sensor_data *data, int state);
+
+int example_sensor_stats_channel_get(struct example_sensor_data *data,
+				     enum sensor_channel chan,
+				     struct sensor_value *val);
+
+int example_sensor_attr_set(const struct device *dev, enum sensor_channel chan,
+			    enum sensor_attribute attr,
+			    const struct sensor_value *val);
+#endif /* CONFIG_EXAMPLE_SENSOR_STATS */
+
+#ifdef CONFIG_EXAMPLE_SENSOR_INPUT
+void example_sensor_input_init(const struct device *dev, int state);
+
+void example_sensor_input_update(const struct device *dev, int state);
+#endif /* CONFIG_EXAMPLE_SENSOR_INPUT */
+
+#ifdef CONFIG_EXAMPLE_SENSOR_ASYNC
+void example_sensor_submit(const struct device *dev,
+			   struct rtio_iodev_sqe *iodev_sqe);
+
+int example_sensor_get_decoder(const struct device *dev,
+			       const struct sensor_decoder_api **decoder);
+#endif /* CONFIG_EXAMPLE_SENSOR_ASYNC */
+
+#endif /* ZEPHYR_DRIVERS_SENSOR_EXAMPLE_SENSOR_H_ */
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT zephyr_example_sensor_adc
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/adc.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/util.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(example_sensor_adc, CONFIG_SENSOR_LOG_LEVEL);
+
+#define BLOCK_SIZE CONFIG_EXAMPLE_SENSOR_ADC_BLOCK_SIZE
+
+/*
+ * The ADC samples continuously into one of two blocks while the driver
+ * thread runs threshold detection on the other one, so that no sample is
+ * lost between sequences and the detection cost is paid once per block.
+ */
+
+struct example_sensor_adc_data {
+	uint16_t blocks[2][BLOCK_SIZE];
+	struct adc_sequence_options options;
+	struct adc_sequence sequence;
+	struct k_poll_signal signal;
+	/* Protects level, raw and error, updated by the driver thread */
+	struct k_spinlock lock;
+	int level;
+	uint16_t raw;
+	/* Why sampling stopped, 0 while it runs */
+	int error;
+	/* Values returned by channel_get, latched on sample fetch */
+	int state;
+	uint16_t distance;
+	K_KERNEL_STACK_MEMBER(thread_stack,
+			      CONFIG_EXAMPLE_SENSOR_ADC_THREAD_STACK_SIZE);
+	struct k_thread thread;
+};
+
+struct example_sensor_adc_config {
+	struct adc_dt_spec channel;
+	/** Near at or below this raw value. */
+	uint16_t threshold;
+	/** Far again above threshold + hysteresis. */
+	uint16_t hysteresis;
+	uint32_t sample_interval_us;
+};
+
+/*
+ * Hysteresis comparator over a block. The band check on the block extremes
+ * settles most blocks without looking at individual samples.
+ */
+static int
+example_sensor_adc_detect(const struct example_sensor_adc_config *config,
+			  int level, const uint16_t *block)
+{
+	uint32_t far = (uint32_t)config->threshold + config->hysteresis;
+	uint16_t min = UINT16_MAX;
+	uint16_t max = 0U;
+
+	for (size_t i = 0U; i < BLOCK_SIZE; i++) {
+		min = MIN(min, block[i]);
+		max = MAX(max, block[i]);
+	}
+
+	if ((level == 0) && (min > config->threshold)) {
+		return 0;
+	}
+
+	if ((level == 1) && (max <= far)) {
+		return 1;
+	}
+
+	/* The block crosses the band: replay it to get the final level */
+	for (size_t i = 0U; i < BLOCK_SIZE; i++) {
+		if ((level == 0) && (block[i] <= config->threshold)) {
+			level = 1;
+		} else if ((level == 1) && (block[i] > far)) {
+			level = 0;
+		}
+	}
+
+	return level;
+}
+
+static int example_sensor_adc_start(const struct device *dev, size_t block)
+{
+	const struct example_sensor_adc_config *config = dev->config;
+	struct example_sensor_adc_data *data = dev->data;
+
+	data->sequence.buffer = data->blocks[block];
+	k_poll_signal_reset(&data->signal);
+
+	return adc_read_async(config->channel.dev, &data->sequence,
+			      &data->signal);
+}
+
+static void example_sensor_adc_thread(void *p1, void *p2, void *p3)
+{
+	const struct device *dev = p1;
+	const struct example_sensor_adc_config *config = dev->config;
+	struct example_sensor_adc_data *data = dev->data;
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &data->signal);
+	k_spinlock_key_t key;
+	size_t block = 0U;
+	int level = 0;
+	int ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	ret = example_sensor_adc_start(dev, block);
+
+	while (ret == 0) {
+		(void)k_poll(&event, 1, K_FOREVER);
+		event.state = K_POLL_STATE_NOT_READY;
+
+		ret = data->signal.result;
+		if (ret < 0) {
+			break;
+		}
+
+		/* Keep the ADC busy on the other block during detection */
+		ret = example_sensor_adc_start(dev, block ^ 1U);
+
+		level = example_sensor_adc_detect(config, level,
+						  data->blocks[block]);
+
+		key = k_spin_lock(&data->lock);
+		data->level = level;
+		data->raw = data->blocks[block][BLOCK_SIZE - 1U];
+		k_spin_unlock(&data->lock, key);
+
+		block ^= 1U;
+	}
+
+	key = k_spin_lock(&data->lock);
+	data->error = ret;
+	k_spin_unlock(&data->lock, key);
+
+	LOG_ERR("%s: sampling stopped (%d)", dev->name, ret);
+}
+
+static int example_sensor_adc_sample_fetch(const struct device *dev,
+					   enum sensor_channel chan)
+{
+	struct example_sensor_adc_data *data = dev->data;
+	k_spinlock_key_t key;
+	int ret;
+
+	if ((chan != SENSOR_CHAN_ALL) && (chan != SENSOR_CHAN_PROX) &&
+	    (chan != SENSOR_CHAN_DISTANCE)) {
+		return -ENOTSUP;
+	}
+
+	key = k_spin_lock(&data->lock);
+	/* Never report the last values once sampling stopped */
+	ret = data->error;
+	if (ret == 0) {
+		data->state = data->level;
+		data->distance = data->raw;
+	}
+	k_spin_unlock(&data->lock, key);
+
+	return ret;
+}
+
+static int example_sensor_adc_channel_get(const struct device *dev,
+					  enum sensor_channel chan,
+					  struct sensor_value *val)
+{
+	struct example_sensor_adc_data *data = dev->data;
+
+	switch (chan) {
+	case SENSOR_CHAN_PROX:
+		val->val1 = data->state;
+		val->val2 = 0;
+		return 0;
+	case SENSOR_CHAN_DISTANCE:
+		/* Raw ADC value, calibration is up to the application */
+		val->val1 = data->distance;
+		val->val2 = 0;
+		return 0;
+	default:
+		return -ENOTSUP;
+	}
+}
+
+static DEVICE_API(sensor, example_sensor_adc_api) = {
+	.sample_fetch = &example_sensor_adc_sample_fetch,
+	.channel_get = &example_sensor_adc_channel_get,
+};
+
+static int example_sensor_adc_init(const struct device *dev)
+{
+	const struct example_sensor_adc_config *config = dev->config;
+	struct example_sensor_adc_data *data = dev->data;
+	int ret;
+
+	if (!adc_is_ready_dt(&config->channel)) {
+		LOG_ERR("ADC not ready");
+		return -ENODEV;
+	}
+
+	ret = adc_channel_setup_dt(&config->channel);
+	if (ret < 0) {
+		LOG_ERR("Could not set up ADC channel (%d)", ret);
+		return ret;
+	}
+
+	ret = adc_sequence_init_dt(&config->channel, &data->sequence);
+	if (ret < 0) {
+		return ret;
+	}
+
+	data->options.interval_us = config->sample_interval_us;
+	data->options.extra_samplings = BLOCK_SIZE - 1U;
+	data->sequence.options = &data->options;
+	data->sequence.buffer_size = sizeof(data->blocks[0]);
+
+	k_poll_signal_init(&data->signal);
+
+	k_thread_create(&data->thread, data->thread_stack,
+			K_KERNEL_STACK_SIZEOF(data->thread_stack),
+			example_sensor_adc_thread, (void *)dev, NULL, NULL,
+			CONFIG_EXAMPLE_SENSOR_ADC_THREAD_PRIORITY, 0,
+			K_NO_WAIT);
+	k_thread_name_set(&data->thread, dev->name);
+
+	return 0;
+}
+
+#define EXAMPLE_SENSOR_ADC_INIT(i)					       \
+	BUILD_ASSERT(DT_INST_PROP(i, threshold) +			       \
+		     DT_INST_PROP(i, hysteresis) <= UINT16_MAX,		       \
+		     "threshold + hysteresis must fit in 16 bits");	       \
+									       \
+	static struct example_sensor_adc_data example_sensor_adc_data_##i;    \
+									       \
+	static const struct example_sensor_adc_config			       \
+		example_sensor_adc_config_##i = {			       \
+		.channel = ADC_DT_SPEC_INST_GET(i),			       \
+		.threshold = DT_INST_PROP(i, threshold),		       \
+		.hysteresis = DT_INST_PROP(i, hysteresis),		       \
+		.sample_interval_us = DT_INST_PROP(i, sample_interval_us),    \
+	};								       \
+									       \
+	DEVICE_DT_INST_DEFINE(i, example_sensor_adc_init, NULL,	       \
+			      &example_sensor_adc_data_##i,		       \
+			      &example_sensor_adc_config_##i, POST_KERNEL,     \
+			      CONFIG_SENSOR_INIT_PRIORITY,		       \
+			      &example_sensor_adc_api);
+
+DT_INST_FOREACH_STATUS_OKAY(EXAMPLE_SENSOR_ADC_INIT)
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/pm/device_runtime.h>
+#include <zephyr/rtio/work.h>
+
+#include "example_sensor.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(example_sensor, CONFIG_SENSOR_LOG_LEVEL);
+
+static void example_sensor_submit_sync(struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct sensor_read_config *cfg = iodev_sqe->sqe.iodev->data;
+	const struct example_sensor_config *config = cfg->sensor->config;
+#ifdef CONFIG_EXAMPLE_SENSOR_COUNTERS
+	struct example_sensor_data *data = cfg->sensor->data;
+#endif
+	struct example_sensor_encoded_data *edata;
+	uint32_t buf_len;
+	uint8_t *buf;
+	int ret;
+
+	ret = rtio_sqe_rx_buf(iodev_sqe, sizeof(*edata), sizeof(*edata), &buf,
+			      &buf_len);
+	if (ret < 0) {
+		LOG_ERR("Could not get read buffer (%d)", ret);
+		rtio_iodev_sqe_err(iodev_sqe, ret);
+		return;
+	}
+
+	edata = (struct example_sensor_encoded_data *)buf;
+	edata->timestamp_ns = k_ticks_to_ns_floor64(k_uptime_ticks());
+
+	ret = pm_device_runtime_get(cfg->sensor);
+	if (ret == 0) {
+		ret = gpio_pin_get_dt(&config->input);
+		(void)pm_device_runtime_put(cfg->sensor);
+	}
+
+#ifdef CONFIG_EXAMPLE_SENSOR_COUNTERS
+	STATS_INC(data->counters, fetches);
+	if (ret < 0) {
+		STATS_INC(data->counters, fetch_errors);
+	}
+#endif
+
+	if (ret < 0) {
+		LOG_ERR("Could not read input GPIO (%d)", ret);
+		rtio_iodev_sqe_err(iodev_sqe, ret);
+		return;
+	}
+
+	edata->state = (int8_t)ret;
+
+	rtio_iodev_sqe_ok(iodev_sqe, 0);
+}
+
+void example_sensor_submit(const struct device *dev,
+			   struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct example_sensor_config *config = dev->config;
+	const struct sensor_read_config *cfg = iodev_sqe->sqe.iodev->data;
+	struct rtio_work_req *req;
+
+	if (cfg->is_streaming) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+		return;
+	}
+
+	for (size_t i = 0; i < cfg->count; i++) {
+		if ((cfg->channels[i].chan_type != SENSOR_CHAN_PROX) &&
+		    (cfg->channels[i].chan_type != SENSOR_CHAN_ALL)) {
+			rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+			return;
+		}
+	}
+
+	/* SoC GPIO reads are cheap enough to complete in the caller context */
+	if (!config->on_bus) {
+		example_sensor_submit_sync(iodev_sqe);
+		return;
+	}
+
+	/*
+	 * Expander-backed inputs block for a full bus transaction, so the read
+	 * is handed over to the RTIO work queue and completed from there.
+	 */
+	req = rtio_work_req_alloc();
+	if (req == NULL) {
+		LOG_ERR("Could not allocate RTIO work request");
+		rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		return;
+	}
+
+	rtio_work_req_submit(req, iodev_sqe, example_sensor_submit_sync);
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT zephyr_example_sensor
+
+#include <zephyr/drivers/sensor.h>
+
+#include "example_sensor.h"
+
+static int example_sensor_decoder_get_frame_count(
+	const uint8_t *buffer, struct sensor_chan_spec chan_spec,
+	uint16_t *frame_count)
+{
+	ARG_UNUSED(buffer);
+
+	if ((chan_spec.chan_type != SENSOR_CHAN_PROX) ||
+	    (chan_spec.chan_idx != 0)) {
+		return -ENOTSUP;
+	}
+
+	*frame_count = 1;
+
+	return 0;
+}
+
+static int example_sensor_decoder_get_size_info(
+	struct sensor_chan_spec chan_spec, size_t *base_size,
+	size_t *frame_size)
+{
+	if (chan_spec.chan_type != SENSOR_CHAN_PROX) {
+		return -ENOTSUP;
+	}
+
+	*base_size = sizeof(struct sensor_byte_data);
+	*frame_size = sizeof(struct sensor_byte_data_reading);
+
+	return 0;
+}
+
+static int example_sensor_decoder_decode(const uint8_t *buffer,
+					 struct sensor_chan_spec chan_spec,
+					 uint32_t *fit, uint16_t max_count,
+					 void *data_out)
+{
+	const struct example_sensor_encoded_data *edata =
+		(const struct example_sensor_encoded_data *)buffer;
+	struct sensor_byte_data *out = data_out;
+
+	if ((chan_spec.chan_type != SENSOR_CHAN_PROX) ||
+	    (chan_spec.chan_idx != 0)) {
+		return -ENOTSUP;
+	}
+
+	if ((*fit != 0) || (max_count == 0)) {
+		return 0;
+	}
+
+	out->header.base_timestamp_ns = edata->timestamp_ns;
+	out->header.reading_count = 1;
+	out->readings[0].timestamp_delta = 0;
+	out->readings[0].is_near = edata->state;
+
+	*fit = 1;
+
+	return 1;
+}
+
+SENSOR_DECODER_API_DT_DEFINE() = {
+	.get_frame_count = &example_sensor_decoder_get_frame_count,
+	.get_size_info = &example_sensor_decoder_get_size_info,
+	.decode = &example_sensor_decoder_decode,
+};
+
+int example_sensor_get_decoder(const struct device *dev,
+			       const struct sensor_decoder_api **decoder)
+{
+	ARG_UNUSED(dev);
+
+	*decoder = &SENSOR_DECODER_NAME();
+
+	return 0;
+}
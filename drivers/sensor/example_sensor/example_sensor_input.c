@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/input/input.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+
+#include "example_sensor.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(example_sensor, CONFIG_SENSOR_LOG_LEVEL);
+
+/*
+ * Input events are reported from the GPIO interrupt, at most one per
+ * coalescing window. Edges within the window only update the level, which
+ * is reported once at the end of the window if it differs from the last
+ * reported one, so bounces and short repeats cost no event.
+ */
+
+/* Claim the current level for reporting, or return -1 if already reported */
+static int input_claim_locked(struct example_sensor_input *input, int64_t now)
+{
+	if (input->level == input->reported) {
+		return -1;
+	}
+
+	input->reported = input->level;
+	input->last_report = now;
+
+	return input->level;
+}
+
+static void input_report(const struct device *dev, int level)
+{
+	const struct example_sensor_config *config = dev->config;
+	int ret;
+
+	if (level < 0) {
+		return;
+	}
+
+	/*
+	 * Delivered to the input callbacks right away with
+	 * CONFIG_INPUT_MODE_SYNCHRONOUS, queued to the input thread otherwise.
+	 */
+	ret = input_report_key(dev, (uint16_t)config->input_code, level, true,
+			       K_NO_WAIT);
+	if (ret < 0) {
+		LOG_WRN("%s: input event dropped (%d)", dev->name, ret);
+	}
+}
+
+static void input_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct example_sensor_input *input =
+		CONTAINER_OF(dwork, struct example_sensor_input, work);
+	struct example_sensor_data *data =
+		CONTAINER_OF(input, struct example_sensor_data, input);
+	k_spinlock_key_t key;
+	int level;
+
+	key = k_spin_lock(&input->lock);
+	level = input_claim_locked(input, k_uptime_ticks());
+	k_spin_unlock(&input->lock, key);
+
+	input_report(data->dev, level);
+}
+
+void example_sensor_input_init(const struct device *dev, int state)
+{
+	struct example_sensor_data *data = dev->data;
+
+	data->input.level = state;
+	data->input.reported = state;
+	data->input.last_report = k_uptime_ticks();
+	k_work_init_delayable(&data->input.work, input_work_handler);
+}
+
+void example_sensor_input_update(const struct device *dev, int state)
+{
+	const struct example_sensor_config *config = dev->config;
+	struct example_sensor_data *data = dev->data;
+	struct example_sensor_input *input = &data->input;
+	k_spinlock_key_t key;
+	int64_t window_end;
+	int64_t now;
+	int level = -1;
+
+	if (config->input_code < 0) {
+		return;
+	}
+
+	key = k_spin_lock(&input->lock);
+
+	now = k_uptime_ticks();
+	input->level = state;
+	window_end = input->last_report +
+		     k_ms_to_ticks_ceil64(config->input_coalesce_ms);
+
+	if (now >= window_end) {
+		level = input_claim_locked(input, now);
+	} else {
+		/* Does nothing if already scheduled for this window */
+		(void)k_work_schedule(&input->work,
+				      K_TIMEOUT_ABS_TICKS(window_end));
+	}
+
+	k_spin_unlock(&input->lock, key);
+
+	input_report(dev, level);
+}
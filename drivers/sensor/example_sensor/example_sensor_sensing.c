@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT zephyr_sensing_example_sensor
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/sensing/sensing_sensor.h>
+#include <zephyr/sys/atomic.h>
+
+#include <app/drivers/sensor/example_sensor.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(example_sensor_sensing, CONFIG_SENSOR_LOG_LEVEL);
+
+/*
+ * Sensing subsystem wrapper of an example sensor. The sensing runtime opens
+ * one connection per client, arbitrates the requested intervals and submits
+ * reads to this device at the shortest one, so the underlying sensor is
+ * fetched once per period whatever the number of clients.
+ */
+
+struct example_sensor_sensing_data {
+	atomic_t fetches;
+};
+
+struct example_sensor_sensing_config {
+	const struct device *hw_dev;
+};
+
+static int example_sensor_sensing_attr_set(const struct device *dev,
+					   enum sensor_channel chan,
+					   enum sensor_attribute attr,
+					   const struct sensor_value *val)
+{
+	ARG_UNUSED(chan);
+
+	switch (attr) {
+	case SENSOR_ATTR_SAMPLING_FREQUENCY:
+		/* The input is polled, the runtime paces the reads */
+		LOG_DBG("%s: %d.%06d Hz", dev->name, val->val1, val->val2);
+		return 0;
+	case SENSOR_ATTR_HYSTERESIS:
+		/* A binary input reports every level change */
+		return 0;
+	default:
+		return -ENOTSUP;
+	}
+}
+
+static void example_sensor_sensing_submit(const struct device *dev,
+					  struct rtio_iodev_sqe *sqe)
+{
+	const struct example_sensor_sensing_config *config = dev->config;
+	struct example_sensor_sensing_data *data = dev->data;
+	struct sensing_sensor_value_uint32 *sample;
+	struct sensor_value val;
+	uint32_t buf_len;
+	int ret;
+
+	ret = rtio_sqe_rx_buf(sqe, sizeof(*sample), sizeof(*sample),
+			      (uint8_t **)&sample, &buf_len);
+	if (ret < 0) {
+		LOG_ERR("Could not get read buffer (%d)", ret);
+		rtio_iodev_sqe_err(sqe, ret);
+		return;
+	}
+
+	ret = sensor_sample_fetch_chan(config->hw_dev, SENSOR_CHAN_PROX);
+	if (ret == 0) {
+		/* The only physical fetch, shared by all clients */
+		atomic_inc(&data->fetches);
+
+		ret = sensor_channel_get(config->hw_dev, SENSOR_CHAN_PROX, &val);
+	}
+
+	if (ret < 0) {
+		LOG_ERR("Could not get sample (%d)", ret);
+		rtio_iodev_sqe_err(sqe, ret);
+		return;
+	}
+
+	sample->header.base_timestamp = k_ticks_to_us_floor64(k_uptime_ticks());
+	sample->header.reading_count = 1U;
+	sample->readings[0].timestamp_delta = 0U;
+	sample->readings[0].v = (uint32_t)val.val1;
+
+	rtio_iodev_sqe_ok(sqe, 0);
+}
+
+static DEVICE_API(sensor, example_sensor_sensing_api) = {
+	.attr_set = example_sensor_sensing_attr_set,
+	.submit = example_sensor_sensing_submit,
+};
+
+static const struct sensing_sensor_register_info example_sensor_sensing_reg = {
+	/* Polled: every read is dispatched to the clients that are due */
+	.flags = 0,
+	.sample_size = sizeof(struct sensing_sensor_value_uint32),
+	.sensitivity_count = 0,
+	.version.value = SENSING_SENSOR_VERSION(0, 1, 0, 0),
+};
+
+static int example_sensor_sensing_init(const struct device *dev)
+{
+	const struct example_sensor_sensing_config *config = dev->config;
+
+	if (!device_is_ready(config->hw_dev)) {
+		LOG_ERR("Underlying device %s not ready", config->hw_dev->name);
+		return -ENODEV;
+	}
+
+	return 0;
+}
+
+uint32_t example_sensor_sensing_fetches(const struct device *dev)
+{
+	struct example_sensor_sensing_data *data = dev->data;
+
+	return (uint32_t)atomic_get(&data->fetches);
+}
+
+#define EXAMPLE_SENSOR_SENSING_INIT(i)					       \
+	static struct example_sensor_sensing_data example_sensor_sensing_data_##i;\
+									       \
+	static const struct example_sensor_sensing_config		       \
+		example_sensor_sensing_config_##i = {			       \
+		.hw_dev = DEVICE_DT_GET(DT_INST_PHANDLE(i, underlying_device)),\
+	};								       \
+									       \
+	SENSING_SENSORS_DT_INST_DEFINE(i, &example_sensor_sensing_reg, NULL,   \
+				       example_sensor_sensing_init, NULL,      \
+				       &example_sensor_sensing_data_##i,       \
+				       &example_sensor_sensing_config_##i,     \
+				       POST_KERNEL,			       \
+				       CONFIG_EXAMPLE_SENSOR_SENSING_INIT_PRIORITY,\
+				       &example_sensor_sensing_api);
+
+DT_INST_FOREACH_STATUS_OKAY(EXAMPLE_SENSOR_SENSING_INIT)
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+
+#include <app/drivers/sensor/example_sensor.h>
+
+#include "example_sensor.h"
+
+static void stats_reset_locked(struct example_sensor_stats *stats, int64_t now)
+{
+	stats->edges = 0U;
+	stats->start = now;
+	stats->last_edge = now;
+	stats->active = 0;
+	stats->pulse_min = INT64_MAX;
+	stats->pulse_max = 0;
+}
+
+void example_sensor_stats_init(struct example_sensor_data *data, int state)
+{
+	struct example_sensor_stats *stats = &data->stats;
+
+	stats->state = state;
+	stats_reset_locked(stats, k_uptime_ticks());
+}
+
+void example_sensor_stats_update(struct example_sensor_data *data, int state)
+{
+	struct example_sensor_stats *stats = &data->stats;
+	k_spinlock_key_t key;
+	int64_t now;
+	int64_t width;
+
+	key = k_spin_lock(&stats->lock);
+
+	/* Fetch and interrupt may both report the same edge */
+	if (state == stats->state) {
+		k_spin_unlock(&stats->lock, key);
+		return;
+	}
+
+	now = k_uptime_ticks();
+	width = now - stats->last_edge;
+
+	if (stats->state != 0) {
+		stats->active += width;
+
+		/* Pulses that started before the last reset are incomplete */
+		if (stats->edges > 0U) {
+			stats->pulse_min = MIN(stats->pulse_min, width);
+			stats->pulse_max = MAX(stats->pulse_max, width);
+		}
+	}
+
+	stats->state = state;
+	stats->last_edge = now;
+	stats->edges++;
+
+	k_spin_unlock(&stats->lock, key);
+}
+
+static void ticks_to_sensor_value(int64_t ticks, struct sensor_value *val)
+{
+	(void)sensor_value_from_micro(val, (int64_t)k_ticks_to_us_floor64(ticks));
+}
+
+int example_sensor_stats_channel_get(struct example_sensor_data *data,
+				     enum sensor_channel chan,
+				     struct sensor_value *val)
+{
+	struct example_sensor_stats *stats = &data->stats;
+	struct example_sensor_stats snap;
+	k_spinlock_key_t key;
+	int64_t now;
+	int64_t elapsed;
+
+	key = k_spin_lock(&stats->lock);
+	now = k_uptime_ticks();
+	snap = *stats;
+	k_spin_unlock(&stats->lock, key);
+
+	/* Account for the pulse in progress */
+	if (snap.state != 0) {
+		snap.active += now - snap.last_edge;
+	}
+
+	switch ((enum example_sensor_channel)chan) {
+	case EXAMPLE_SENSOR_CHAN_ACTIVE_TIME:
+		ticks_to_sensor_value(snap.active, val);
+		break;
+	case EXAMPLE_SENSOR_CHAN_DUTY_CYCLE:
+		elapsed = now - snap.start;
+		if (elapsed == 0) {
+			(void)sensor_value_from_micro(
+				val, (snap.state != 0) ? 100000000 : 0);
+			break;
+		}
+		/* Parts per million first, to keep the product within 64 bits */
+		(void)sensor_value_from_micro(
+			val, (snap.active * 1000000 / elapsed) * 100);
+		break;
+	case EXAMPLE_SENSOR_CHAN_EDGE_COUNT:
+		val->val1 = (int32_t)snap.edges;
+		val->val2 = 0;
+		break;
+	case EXAMPLE_SENSOR_CHAN_LAST_EDGE:
+		if (snap.edges == 0U) {
+			return -ENODATA;
+		}
+		ticks_to_sensor_value(snap.last_edge, val);
+		break;
+	case EXAMPLE_SENSOR_CHAN_SINCE_LAST_EDGE:
+		ticks_to_sensor_value(now - snap.last_edge, val);
+		break;
+	case EXAMPLE_SENSOR_CHAN_PULSE_MIN:
+		if (snap.pulse_min == INT64_MAX) {
+			return -ENODATA;
+		}
+		ticks_to_sensor_value(snap.pulse_min, val);
+		break;
+	case EXAMPLE_SENSOR_CHAN_PULSE_MAX:
+		if (snap.pulse_min == INT64_MAX) {
+			return -ENODATA;
+		}
+		ticks_to_sensor_value(snap.pulse_max, val);
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+int example_sensor_attr_set(const struct device *dev, enum sensor_channel chan,
+			    enum sensor_attribute attr,
+			    const struct sensor_value *val)
+{
+	struct example_sensor_data *data = dev->data;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(val);
+
+	if ((chan != SENSOR_CHAN_ALL) ||
+	    (attr != (enum sensor_attribute)EXAMPLE_SENSOR_ATTR_STATS_RESET)) {
+		return -ENOTSUP;
+	}
+
+	key = k_spin_lock(&data->stats.lock);
+	stats_reset_locked(&data->stats, k_uptime_ticks());
+	k_spin_unlock(&data->stats.lock, key);
+
+	return 0;
+}
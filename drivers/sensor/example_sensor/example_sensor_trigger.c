@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/pm/device_runtime.h>
+
+#include "example_sensor.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(example_sensor, CONFIG_SENSOR_LOG_LEVEL);
+
+#if defined(CONFIG_EXAMPLE_SENSOR_THREAD_META_IRQ)
+/* Highest cooperative priority, which is a meta-IRQ priority */
+#define EXAMPLE_SENSOR_THREAD_PRIORITY K_HIGHEST_THREAD_PRIO
+#elif defined(CONFIG_EXAMPLE_SENSOR_TRIGGER_OWN_THREAD)
+#define EXAMPLE_SENSOR_THREAD_PRIORITY                                         \
+	K_PRIO_COOP(CONFIG_EXAMPLE_SENSOR_THREAD_PRIORITY)
+#endif
+
+#ifdef CONFIG_EXAMPLE_SENSOR_TRIGGER
+static void example_sensor_handle_edge(struct example_sensor_data *data)
+{
+	sensor_trigger_handler_t handler = data->handler;
+
+	if (handler != NULL) {
+		handler(data->dev, data->trigger);
+	}
+}
+#endif /* CONFIG_EXAMPLE_SENSOR_TRIGGER */
+
+/* Called from the GPIO interrupt, with the input level when it is needed */
+static void example_sensor_handle_interrupt(struct example_sensor_data *data,
+					    int state)
+{
+	ARG_UNUSED(state);
+
+#ifdef CONFIG_EXAMPLE_SENSOR_STATS
+	example_sensor_stats_update(data, state);
+#endif
+
+#ifdef CONFIG_EXAMPLE_SENSOR_INPUT
+	example_sensor_input_update(data->dev, state);
+#endif
+
+#ifdef CONFIG_EXAMPLE_SENSOR_COUNTERS
+	STATS_INC(data->counters, edges);
+	/* Same level as on the previous interrupt: an edge was missed */
+	if (state == data->last_level) {
+		STATS_INC(data->counters, edges_dropped);
+	}
+	data->last_level = state;
+#endif
+
+#if defined(CONFIG_EXAMPLE_SENSOR_TRIGGER_OWN_THREAD)
+	k_sem_give(&data->gpio_sem);
+#elif defined(CONFIG_EXAMPLE_SENSOR_TRIGGER_GLOBAL_THREAD)
+	k_work_submit(&data->work);
+#endif
+}
+
+#ifdef CONFIG_EXAMPLE_SENSOR_PORT_SENSE
+/* Instances sharing an input port, and a single callback */
+struct example_sensor_port {
+	const struct device *port;
+	struct gpio_callback cb;
+	/* Protects latched against the callback */
+	struct k_spinlock lock;
+	/* Input pins of the instances */
+	gpio_port_pins_t pins;
+	/* Raw port input at the previous interrupt, or when the instance of a
+	 * pin was added or resumed
+	 */
+	gpio_port_value_t latched;
+	sys_slist_t sensors;
+};
+
+/* At most one port per instance */
+static struct example_sensor_port
+	example_sensor_ports[DT_NUM_INST_STATUS_OKAY(zephyr_example_sensor)];
+
+static void example_sensor_port_callback(const struct device *port,
+					 struct gpio_callback *cb,
+					 uint32_t pins)
+{
+	struct example_sensor_port *group =
+		CONTAINER_OF(cb, struct example_sensor_port, cb);
+	const struct example_sensor_config *config;
+	struct example_sensor_data *data;
+	gpio_port_pins_t changed = 0U;
+	gpio_port_value_t value;
+	k_spinlock_key_t key;
+	int state;
+	int ret;
+
+	ARG_UNUSED(pins);
+
+	key = k_spin_lock(&group->lock);
+
+	/* One read for every instance on the port. The GPIO driver calls
+	 * back once per latched pin, and the first call already handles the
+	 * pins of the others, so only a level change against the latched
+	 * value counts.
+	 */
+	ret = gpio_port_get_raw(port, &value);
+	if (ret == 0) {
+		changed = (value ^ group->latched) & group->pins;
+		group->latched = value;
+	}
+
+	k_spin_unlock(&group->lock, key);
+
+	if (ret < 0) {
+		return;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&group->sensors, data, port_node) {
+		config = data->dev->config;
+
+		if ((changed & BIT(config->input.pin)) == 0U) {
+			continue;
+		}
+
+		state = (value >> config->input.pin) & 1U;
+		if ((config->input.dt_flags & GPIO_ACTIVE_LOW) != 0U) {
+			state = !state;
+		}
+
+		example_sensor_handle_interrupt(data, state);
+	}
+}
+
+/* Group of the input port, or a free one */
+static struct example_sensor_port *
+example_sensor_port_find(const struct device *port)
+{
+	for (size_t i = 0U; i < ARRAY_SIZE(example_sensor_ports); i++) {
+		if ((example_sensor_ports[i].port == NULL) ||
+		    (example_sensor_ports[i].port == port)) {
+			return &example_sensor_ports[i];
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Take the current input level as the reference for the next interrupt.
+ * Only the pin of the instance is updated, the others may have edges
+ * pending for their own instances.
+ */
+static int example_sensor_port_latch(const struct device *dev)
+{
+	const struct example_sensor_config *config = dev->config;
+	struct example_sensor_port *group =
+		example_sensor_port_find(config->input.port);
+	gpio_port_pins_t pin = BIT(config->input.pin);
+	gpio_port_value_t value;
+	k_spinlock_key_t key;
+	int ret;
+
+	key = k_spin_lock(&group->lock);
+
+	ret = gpio_port_get_raw(config->input.port, &value);
+	if (ret == 0) {
+		group->latched = (group->latched & ~pin) | (value & pin);
+	}
+
+	k_spin_unlock(&group->lock, key);
+
+	return ret;
+}
+
+static int example_sensor_port_add(const struct device *dev)
+{
+	const struct example_sensor_config *config = dev->config;
+	struct example_sensor_data *data = dev->data;
+	struct example_sensor_port *group =
+		example_sensor_port_find(config->input.port);
+	k_spinlock_key_t key;
+	int ret;
+
+	__ASSERT_NO_MSG(group != NULL);
+
+	if (group->port == NULL) {
+		sys_slist_init(&group->sensors);
+		gpio_init_callback(&group->cb, example_sensor_port_callback,
+				   0U);
+
+		ret = gpio_add_callback(config->input.port, &group->cb);
+		if (ret < 0) {
+			LOG_ERR("Could not add input port callback (%d)", ret);
+			return ret;
+		}
+
+		group->port = config->input.port;
+	}
+
+	ret = example_sensor_port_latch(dev);
+	if (ret < 0) {
+		LOG_ERR("Could not read input port (%d)", ret);
+		return ret;
+	}
+
+	key = k_spin_lock(&group->lock);
+	sys_slist_append(&group->sensors, &data->port_node);
+	group->pins |= BIT(config->input.pin);
+	group->cb.pin_mask = group->pins;
+	k_spin_unlock(&group->lock, key);
+
+	return 0;
+}
+#else
+static void example_sensor_gpio_callback(const struct device *port,
+					 struct gpio_callback *cb,
+					 uint32_t pins)
+{
+	struct example_sensor_data *data =
+		CONTAINER_OF(cb, struct example_sensor_data, gpio_cb);
+	int state = 0;
+
+	ARG_UNUSED(port);
+	ARG_UNUSED(pins);
+
+#if defined(CONFIG_EXAMPLE_SENSOR_STATS) ||                                    \
+	defined(CONFIG_EXAMPLE_SENSOR_INPUT) ||                                \
+	defined(CONFIG_EXAMPLE_SENSOR_COUNTERS)
+	const struct example_sensor_config *config = data->dev->config;
+
+	state = gpio_pin_get_dt(&config->input);
+#endif
+
+	example_sensor_handle_interrupt(data, state);
+}
+#endif /* CONFIG_EXAMPLE_SENSOR_PORT_SENSE */
+
+#if defined(CONFIG_EXAMPLE_SENSOR_TRIGGER_OWN_THREAD)
+static void example_sensor_thread(void *p1, void *p2, void *p3)
+{
+	struct example_sensor_data *data = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&data->gpio_sem, K_FOREVER);
+		example_sensor_handle_edge(data);
+	}
+}
+#elif defined(CONFIG_EXAMPLE_SENSOR_TRIGGER_GLOBAL_THREAD)
+static void example_sensor_work_cb(struct k_work *work)
+{
+	struct example_sensor_data *data =
+		CONTAINER_OF(work, struct example_sensor_data, work);
+
+	example_sensor_handle_edge(data);
+}
+#endif
+
+#ifdef CONFIG_EXAMPLE_SENSOR_TRIGGER
+static int example_sensor_trigger_apply(const struct device *dev,
+					const struct sensor_trigger *trig,
+					sensor_trigger_handler_t handler)
+{
+	const struct example_sensor_config *config = dev->config;
+	struct example_sensor_data *data = dev->data;
+	__maybe_unused int ret;
+
+#if defined(CONFIG_EXAMPLE_SENSOR_STATS) ||                                    \
+	defined(CONFIG_EXAMPLE_SENSOR_INPUT) ||                                \
+	defined(CONFIG_EXAMPLE_SENSOR_COUNTERS)
+	/* Interrupts stay enabled for statistics, input events and counters,
+	 * a handler would never be called if that failed
+	 */
+	if ((handler != NULL) && (data->interrupt_ret < 0)) {
+		return data->interrupt_ret;
+	}
+
+	data->trigger = trig;
+	data->handler = handler;
+
+	ARG_UNUSED(config);
+
+	return 0;
+#else
+	ret = gpio_pin_interrupt_configure_dt(&config->input, GPIO_INT_DISABLE);
+	if (ret < 0) {
+		return ret;
+	}
+
+	data->handler = handler;
+	data->trigger = trig;
+
+	if (handler == NULL) {
+		return 0;
+	}
+
+	return gpio_pin_interrupt_configure_dt(&config->input,
+					       GPIO_INT_EDGE_BOTH);
+#endif
+}
+
+int example_sensor_trigger_set(const struct device *dev,
+			       const struct sensor_trigger *trig,
+			       sensor_trigger_handler_t handler)
+{
+	struct example_sensor_data *data = dev->data;
+	bool was_set = (data->handler != NULL);
+	int ret;
+
+	if ((trig->type != SENSOR_TRIG_NEAR_FAR) ||
+	    ((trig->chan != SENSOR_CHAN_PROX) &&
+	     (trig->chan != SENSOR_CHAN_ALL))) {
+		return -ENOTSUP;
+	}
+
+	/* The input stays resumed while a handler is set */
+	if ((handler != NULL) && !was_set) {
+		ret = pm_device_runtime_get(dev);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	ret = example_sensor_trigger_apply(dev, trig, handler);
+
+	if ((ret < 0) && (handler != NULL) && !was_set) {
+		(void)pm_device_runtime_put(dev);
+	} else if ((ret == 0) && (handler == NULL) && was_set) {
+		(void)pm_device_runtime_put(dev);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_EXAMPLE_SENSOR_TRIGGER */
+
+int example_sensor_resume_interrupt(const struct device *dev)
+{
+	const struct example_sensor_config *config = dev->config;
+	struct example_sensor_data *data = dev->data;
+	__maybe_unused int ret;
+
+#ifdef CONFIG_EXAMPLE_SENSOR_COUNTERS
+	/* Edges were not seen while suspended */
+	data->last_level = gpio_pin_get_dt(&config->input);
+#endif
+
+#ifdef CONFIG_EXAMPLE_SENSOR_PORT_SENSE
+	/* Neither by the port callback, which must not report them later */
+	(void)example_sensor_port_latch(dev);
+#endif
+
+#if defined(CONFIG_EXAMPLE_SENSOR_STATS) ||                                    \
+	defined(CONFIG_EXAMPLE_SENSOR_INPUT) ||                                \
+	defined(CONFIG_EXAMPLE_SENSOR_COUNTERS)
+	/* Reported by example_sensor_init_interrupt() when not available */
+	ret = gpio_pin_interrupt_configure_dt(&config->input,
+					      GPIO_INT_EDGE_BOTH);
+#ifdef CONFIG_EXAMPLE_SENSOR_TRIGGER
+	data->interrupt_ret = ret;
+#else
+	ARG_UNUSED(data);
+#endif
+
+	return 0;
+#elif defined(CONFIG_EXAMPLE_SENSOR_TRIGGER)
+	if (data->handler == NULL) {
+		return 0;
+	}
+
+	return gpio_pin_interrupt_configure_dt(&config->input,
+					       GPIO_INT_EDGE_BOTH);
+#else
+	ARG_UNUSED(config);
+	ARG_UNUSED(data);
+
+	return 0;
+#endif
+}
+
+int example_sensor_init_interrupt(const struct device *dev)
+{
+	const struct example_sensor_config *config = dev->config;
+	struct example_sensor_data *data = dev->data;
+	int ret;
+
+	data->dev = dev;
+
+#ifdef CONFIG_EXAMPLE_SENSOR_PORT_SENSE
+	ret = example_sensor_port_add(dev);
+	if (ret < 0) {
+		return ret;
+	}
+#else
+	gpio_init_callback(&data->gpio_cb, example_sensor_gpio_callback,
+			   BIT(config->input.pin));
+
+	ret = gpio_add_callback_dt(&config->input, &data->gpio_cb);
+	if (ret < 0) {
+		LOG_ERR("Could not add input GPIO callback (%d)", ret);
+		return ret;
+	}
+#endif
+
+#if defined(CONFIG_EXAMPLE_SENSOR_TRIGGER_OWN_THREAD)
+	k_sem_init(&data->gpio_sem, 0, K_SEM_MAX_LIMIT);
+
+	k_thread_create(&data->thread, data->thread_stack,
+			K_KERNEL_STACK_SIZEOF(data->thread_stack),
+			example_sensor_thread, data, NULL, NULL,
+			EXAMPLE_SENSOR_THREAD_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&data->thread, dev->name);
+#elif defined(CONFIG_EXAMPLE_SENSOR_TRIGGER_GLOBAL_THREAD)
+	k_work_init(&data->work, example_sensor_work_cb);
+#endif
+
+#ifdef CONFIG_EXAMPLE_SENSOR_INPUT
+	example_sensor_input_init(dev, gpio_pin_get_dt(&config->input));
+#endif
+
+#ifdef CONFIG_EXAMPLE_SENSOR_COUNTERS
+	data->last_level = gpio_pin_get_dt(&config->input);
+#endif
+
+#if defined(CONFIG_EXAMPLE_SENSOR_STATS) ||                                    \
+	defined(CONFIG_EXAMPLE_SENSOR_INPUT) ||                                \
+	defined(CONFIG_EXAMPLE_SENSOR_COUNTERS)
+	ret = gpio_pin_interrupt_configure_dt(&config->input,
+					      GPIO_INT_EDGE_BOTH);
+	if (ret < 0) {
+		/* No input events, statistics only updated on fetch */
+		LOG_WRN("Input GPIO interrupt not available (%d)", ret);
+	}
+#ifdef CONFIG_EXAMPLE_SENSOR_TRIGGER
+	data->interrupt_ret = ret;
+#endif
+#endif
+
+	return 0;
+}
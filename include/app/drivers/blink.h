@@ -6,6 +6,8 @@
 #ifndef APP_DRIVERS_BLINK_H_
 #define APP_DRIVERS_BLINK_H_
 
+#include <stddef.h>
+
 #include <zephyr/device.h>
 #include <zephyr/toolchain.h>
 
@@ -87,6 +89,40 @@ static inline int z_impl_blink_set_period_ms(const struct device *dev,
 	return DEVICE_API_GET(blink, dev)->set_period_ms(dev, period_ms);
 }
 
+/**
+ * @brief Configure the blink period of multiple LEDs at once.
+ *
+ * Applies @p periods to @p devs in order, as if blink_set_period_ms() was
+ * called for each of them, but pays the system call cost only once when
+ * called from user mode. Processing stops at the first failure.
+ *
+ * @param devs Blink device instances.
+ * @param periods Period of each LED blink in milliseconds.
+ * @param n Number of entries in @p devs and @p periods.
+ *
+ * @retval 0 if successful.
+ * @retval -EINVAL if one of @p periods can not be set.
+ * @retval -errno Other negative errno code on failure.
+ */
+__syscall int blink_set_period_ms_many(const struct device **devs,
+				       const unsigned int *periods, size_t n);
+
+static inline int z_impl_blink_set_period_ms_many(const struct device **devs,
+						  const unsigned int *periods,
+						  size_t n)
+{
+	int ret;
+
+	for (size_t i = 0; i < n; i++) {
+		ret = z_impl_blink_set_period_ms(devs[i], periods[i]);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
 /**
  * @brief Turn LED blinking off.
  *
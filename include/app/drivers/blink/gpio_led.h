@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_DRIVERS_BLINK_GPIO_LED_H_
+#define APP_DRIVERS_BLINK_GPIO_LED_H_
+
+#include <zephyr/device.h>
+#ifdef CONFIG_BLINK_GPIO_LED_COUNTERS
+#include <zephyr/stats/stats.h>
+#endif
+
+/**
+ * @defgroup drivers_blink_gpio_led GPIO blink LED
+ * @ingroup drivers_blink
+ * @{
+ *
+ * @brief Private API and counters of the GPIO-controlled LED blink driver.
+ */
+
+#if defined(CONFIG_BLINK_GPIO_LED_TEST_HOOKS) || defined(__DOXYGEN__)
+/**
+ * @brief Run the blink timer expiry handler once.
+ *
+ * Toggles the LED as the blink timer ISR does, without waiting for the
+ * timer. Meant for benchmarks of the toggle path, requires
+ * CONFIG_BLINK_GPIO_LED_TEST_HOOKS.
+ *
+ * @param dev GPIO blink LED device instance.
+ */
+void blink_gpio_led_timer_expire(const struct device *dev);
+#endif
+
+#if defined(CONFIG_BLINK_GPIO_LED_COUNTERS) || defined(__DOXYGEN__)
+/**
+ * @brief Performance counters.
+ *
+ * Registered as a stats group named after the device, which
+ * stats_group_find() returns as the @c s_hdr member.
+ */
+STATS_SECT_START(blink_gpio_led_counters)
+STATS_SECT_ENTRY32(timer_expiries)
+STATS_SECT_ENTRY32(toggle_failures)
+STATS_SECT_ENTRY32(period_changes)
+STATS_SECT_END;
+#endif
+
+/** @} */
+
+#endif /* APP_DRIVERS_BLINK_GPIO_LED_H_ */
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_DRIVERS_GPIO_FAST_H_
+#define APP_DRIVERS_GPIO_FAST_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/sys/util.h>
+
+#if defined(CONFIG_DRIVERS_GPIO_FAST)
+#include <soc.h>
+#endif
+
+/**
+ * @defgroup drivers_gpio_fast Direct-register GPIO access
+ * @ingroup drivers
+ * @{
+ *
+ * @brief Helpers to access GPIO pins through the port registers.
+ *
+ * Drivers in this module may use these helpers on their hot paths to read or
+ * toggle a pin with a single register access, bypassing the GPIO driver API.
+ * Pins are still configured through the GPIO API. Only SoC GPIO ports of the
+ * supported series (nRF52, STM32) are handled; drivers must fall back to the
+ * GPIO API when gpio_fast_pin_enabled() returns false.
+ */
+
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_DRIVERS_GPIO_FAST) && defined(CONFIG_SOC_SERIES_NRF52X)
+#define GPIO_FAST_COMPAT nordic_nrf_gpio
+#elif defined(CONFIG_DRIVERS_GPIO_FAST) && defined(CONFIG_SOC_FAMILY_STM32)
+#define GPIO_FAST_COMPAT st_stm32_gpio
+#endif
+/** @endcond */
+
+/**
+ * @brief Get the register base address of the port of a GPIO property.
+ *
+ * @param node_id Devicetree node identifier.
+ * @param prop Lowercase-and-underscores GPIO property name.
+ *
+ * @return Port base address, or 0 if the port can not be accessed directly.
+ */
+#ifdef GPIO_FAST_COMPAT
+#define GPIO_FAST_DT_PORT_ADDR(node_id, prop)                                  \
+	COND_CODE_1(DT_NODE_HAS_COMPAT(DT_GPIO_CTLR(node_id, prop),            \
+				       GPIO_FAST_COMPAT),                      \
+		    ((uintptr_t)DT_REG_ADDR(DT_GPIO_CTLR(node_id, prop))),     \
+		    ((uintptr_t)0U))
+#else
+#define GPIO_FAST_DT_PORT_ADDR(node_id, prop) ((uintptr_t)0U)
+#endif
+
+/**
+ * @brief Get the register base address of the port of a GPIO property of a
+ * `DT_DRV_COMPAT` instance.
+ *
+ * @param inst Instance number.
+ * @param prop Lowercase-and-underscores GPIO property name.
+ *
+ * @return See GPIO_FAST_DT_PORT_ADDR().
+ */
+#define GPIO_FAST_DT_INST_PORT_ADDR(inst, prop)                                \
+	GPIO_FAST_DT_PORT_ADDR(DT_DRV_INST(inst), prop)
+
+/** @brief Pin resolved to its port registers. */
+struct gpio_fast_pin {
+	/** Port register base address, 0 if not available. */
+	uintptr_t port;
+	/** Pin mask within the port. */
+	uint32_t mask;
+	/** Pin is active low. */
+	bool active_low;
+};
+
+/**
+ * @brief Resolve a pin to its port registers.
+ *
+ * @param pin Pin to initialize.
+ * @param port Port base address, see GPIO_FAST_DT_PORT_ADDR().
+ * @param spec GPIO specification of the pin.
+ *
+ * @retval 0 if successful.
+ * @retval -ENOTSUP if the pin can not be accessed directly.
+ */
+static inline int gpio_fast_pin_init(struct gpio_fast_pin *pin, uintptr_t port,
+				     const struct gpio_dt_spec *spec)
+{
+	pin->port = port;
+	pin->mask = BIT(spec->pin);
+	pin->active_low = (spec->dt_flags & GPIO_ACTIVE_LOW) != 0U;
+
+	return (port != 0U) ? 0 : -ENOTSUP;
+}
+
+/**
+ * @brief Check if a pin can be accessed directly.
+ *
+ * @param pin Pin.
+ *
+ * @retval true if gpio_fast_pin_get() and gpio_fast_pin_toggle() can be used.
+ * @retval false otherwise.
+ */
+static inline bool gpio_fast_pin_enabled(const struct gpio_fast_pin *pin)
+{
+#ifdef GPIO_FAST_COMPAT
+	return pin->port != 0U;
+#else
+	ARG_UNUSED(pin);
+
+	return false;
+#endif
+}
+
+/**
+ * @brief Get the logical level of an input pin.
+ *
+ * @param pin Pin, must be enabled.
+ *
+ * @return 1 if the pin is active, 0 otherwise.
+ */
+static inline int gpio_fast_pin_get(const struct gpio_fast_pin *pin)
+{
+	uint32_t in = 0U;
+
+#if defined(CONFIG_SOC_SERIES_NRF52X) && defined(GPIO_FAST_COMPAT)
+	in = ((NRF_GPIO_Type *)pin->port)->IN;
+#elif defined(CONFIG_SOC_FAMILY_STM32) && defined(GPIO_FAST_COMPAT)
+	in = ((GPIO_TypeDef *)pin->port)->IDR;
+#endif
+
+	return (int)(((in & pin->mask) != 0U) != pin->active_low);
+}
+
+/**
+ * @brief Toggle an output pin.
+ *
+ * @param pin Pin, must be enabled.
+ */
+static inline void gpio_fast_pin_toggle(const struct gpio_fast_pin *pin)
+{
+#if defined(CONFIG_SOC_SERIES_NRF52X) && defined(GPIO_FAST_COMPAT)
+	NRF_GPIO_Type *reg = (NRF_GPIO_Type *)pin->port;
+	uint32_t out = reg->OUT;
+
+	reg->OUTSET = ~out & pin->mask;
+	reg->OUTCLR = out & pin->mask;
+#elif defined(CONFIG_SOC_FAMILY_STM32) && defined(GPIO_FAST_COMPAT)
+	GPIO_TypeDef *reg = (GPIO_TypeDef *)pin->port;
+	uint32_t odr = reg->ODR;
+
+	reg->BSRR = ((odr & pin->mask) << 16) | (~odr & pin->mask);
+#else
+	ARG_UNUSED(pin);
+#endif
+}
+
+/** @} */
+
+#endif /* APP_DRIVERS_GPIO_FAST_H_ */
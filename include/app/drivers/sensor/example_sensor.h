@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_DRIVERS_SENSOR_EXAMPLE_SENSOR_H_
+#define APP_DRIVERS_SENSOR_EXAMPLE_SENSOR_H_
+
+#include <zephyr/drivers/sensor.h>
+#ifdef CONFIG_EXAMPLE_SENSOR_COUNTERS
+#include <zephyr/stats/stats.h>
+#endif
+
+/**
+ * @defgroup drivers_sensor_example_sensor Example sensor
+ * @ingroup drivers
+ * @{
+ *
+ * @brief Private channels and attributes of the example sensor.
+ *
+ * Statistics channels are available with CONFIG_EXAMPLE_SENSOR_STATS. They
+ * are maintained incrementally on every input edge, so reading them does not
+ * require a prior sample fetch.
+ *
+ * With CONFIG_EXAMPLE_SENSOR_SENSING, "zephyr,sensing-example-sensor" nodes
+ * expose example sensors to sensing subsystem clients.
+ */
+
+/** @brief Example sensor private channels. */
+enum example_sensor_channel {
+	/** Accumulated time the input has been active, in seconds. */
+	EXAMPLE_SENSOR_CHAN_ACTIVE_TIME = SENSOR_CHAN_PRIV_START,
+	/** Active time over elapsed time since the last reset, in percent. */
+	EXAMPLE_SENSOR_CHAN_DUTY_CYCLE,
+	/** Number of edges (both directions) since the last reset. */
+	EXAMPLE_SENSOR_CHAN_EDGE_COUNT,
+	/** Uptime of the last edge, in seconds (-ENODATA if none). */
+	EXAMPLE_SENSOR_CHAN_LAST_EDGE,
+	/** Time elapsed since the last edge (or reset), in seconds. */
+	EXAMPLE_SENSOR_CHAN_SINCE_LAST_EDGE,
+	/** Shortest completed active pulse, in seconds (-ENODATA if none). */
+	EXAMPLE_SENSOR_CHAN_PULSE_MIN,
+	/** Longest completed active pulse, in seconds (-ENODATA if none). */
+	EXAMPLE_SENSOR_CHAN_PULSE_MAX,
+};
+
+/** @brief Example sensor private attributes. */
+enum example_sensor_attribute {
+	/**
+	 * Reset the statistics (value is ignored). Use with
+	 * @ref SENSOR_CHAN_ALL.
+	 */
+	EXAMPLE_SENSOR_ATTR_STATS_RESET = SENSOR_ATTR_PRIV_START,
+};
+
+#if defined(CONFIG_EXAMPLE_SENSOR_COUNTERS) || defined(__DOXYGEN__)
+/**
+ * @brief Performance counters.
+ *
+ * Registered as a stats group named after the device, which
+ * stats_group_find() returns as the @c s_hdr member.
+ */
+STATS_SECT_START(example_sensor_counters)
+STATS_SECT_ENTRY32(fetches)
+STATS_SECT_ENTRY32(fetch_errors)
+STATS_SECT_ENTRY32(edges)
+STATS_SECT_ENTRY32(edges_dropped)
+STATS_SECT_END;
+#endif
+
+#if defined(CONFIG_EXAMPLE_SENSOR_SENSING) || defined(__DOXYGEN__)
+/**
+ * Sensing subsystem type of the example sensor wrappers (HID usage
+ * Biometric: Human Proximity), to be used in their @c sensor-types property
+ * and to find them with sensing_get_sensors().
+ */
+#define EXAMPLE_SENSOR_SENSING_TYPE_PROXIMITY 0x12
+
+/**
+ * @brief Number of physical fetches done by a sensing wrapper.
+ *
+ * The sensing runtime reads the wrapper once per arbitrated interval and
+ * dispatches the sample to all its clients, this counter is therefore
+ * independent of the number of clients.
+ *
+ * @param dev "zephyr,sensing-example-sensor" device.
+ *
+ * @return Number of successful fetches of the underlying sensor since boot.
+ */
+uint32_t example_sensor_sensing_fetches(const struct device *dev);
+#endif
+
+/** @} */
+
+#endif /* APP_DRIVERS_SENSOR_EXAMPLE_SENSOR_H_ */
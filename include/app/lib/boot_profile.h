@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_LIB_BOOT_PROFILE_H_
+#define APP_LIB_BOOT_PROFILE_H_
+
+#include <errno.h>
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+
+/**
+ * @defgroup lib_boot_profile Boot profile library
+ * @ingroup lib
+ * @{
+ *
+ * @brief Timestamps of the boot phases up to the first valid sample.
+ *
+ * Each phase is timestamped the first time it is marked, relative to the
+ * start of the system clock. Once @ref BOOT_PROFILE_FIRST_SAMPLE is marked
+ * the profile is reported through logging. When CONFIG_BOOT_PROFILE is
+ * disabled all functions compile to nothing.
+ */
+
+/** @brief Boot phases. */
+enum boot_profile_phase {
+	/** Kernel services are up (first POST_KERNEL initialization). */
+	BOOT_PROFILE_KERNEL,
+	/** Sensor driver initialization started. */
+	BOOT_PROFILE_SENSOR_INIT,
+	/** Sensor driver initialization completed. */
+	BOOT_PROFILE_SENSOR_READY,
+	/** Blink driver initialization started. */
+	BOOT_PROFILE_BLINK_INIT,
+	/** Blink driver initialization completed. */
+	BOOT_PROFILE_BLINK_READY,
+	/** Application main() entered. */
+	BOOT_PROFILE_MAIN,
+	/** First valid sample obtained by the application. */
+	BOOT_PROFILE_FIRST_SAMPLE,
+
+	/** @cond INTERNAL_HIDDEN */
+	BOOT_PROFILE_NUM_PHASES,
+	/** @endcond */
+};
+
+#if defined(CONFIG_BOOT_PROFILE) || defined(__DOXYGEN__)
+/**
+ * @brief Mark a boot phase.
+ *
+ * Only the first mark of each phase is recorded, so this can be called from
+ * paths that run repeatedly or for every driver instance.
+ *
+ * @param phase Boot phase.
+ */
+void boot_profile_mark(enum boot_profile_phase phase);
+
+/**
+ * @brief Get the timestamp of a boot phase.
+ *
+ * @param phase Boot phase.
+ * @param[out] us Microseconds since the start of the system clock.
+ *
+ * @retval 0 if successful.
+ * @retval -ENODATA if @p phase has not been marked yet.
+ */
+int boot_profile_get_us(enum boot_profile_phase phase, uint32_t *us);
+#else
+static inline void boot_profile_mark(enum boot_profile_phase phase)
+{
+	ARG_UNUSED(phase);
+}
+
+static inline int boot_profile_get_us(enum boot_profile_phase phase,
+				      uint32_t *us)
+{
+	ARG_UNUSED(phase);
+	ARG_UNUSED(us);
+
+	return -ENODATA;
+}
+#endif /* CONFIG_BOOT_PROFILE */
+
+/** @} */
+
+#endif /* APP_LIB_BOOT_PROFILE_H_ */
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_LIB_CONTROL_MAP_H_
+#define APP_LIB_CONTROL_MAP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+
+#ifdef CONFIG_CONTROL_MAP_ZBUS
+#include <zephyr/zbus/zbus.h>
+#endif
+
+#include <app/lib/edge_detect.h>
+
+/**
+ * @defgroup lib_control_map Control map library
+ * @ingroup lib
+ * @{
+ *
+ * @brief Sensor to LED pairs served by a single control loop.
+ *
+ * Pairs are listed as children of the "zephyr,example-control-map"
+ * devicetree node, and turned into a constant table at build time. When no
+ * such node exists, a single pair made of the @c example_sensor and
+ * @c blink_led node labels is used. The control loop gathers the proximity
+ * level of every pair into a packed snapshot and hands it to
+ * control_map_update(), which detects edges for all pairs at once and updates
+ * the LED blinking periods. Per-pair RAM usage is the current period and the
+ * edge detector bits. With CONFIG_CONTROL_MAP_ZBUS, every control step is
+ * also published on a zbus channel, so that other consumers do not need to
+ * read the sensors again.
+ */
+
+/** @cond INTERNAL_HIDDEN */
+#define CONTROL_MAP_DEFAULT_STEP_MS 100
+#define CONTROL_MAP_DEFAULT_MAX_MS  1000
+
+#if DT_HAS_COMPAT_STATUS_OKAY(zephyr_example_control_map)
+#define CONTROL_MAP_NODE                                                       \
+	DT_COMPAT_GET_ANY_STATUS_OKAY(zephyr_example_control_map)
+
+#define CONTROL_MAP_PAIR_EXPAND(pair, fn)                                      \
+	fn(DT_DEP_ORD(pair), DT_PHANDLE(pair, sensor), DT_PHANDLE(pair, led),  \
+	   DT_PROP(pair, period_step_ms), DT_PROP(pair, period_max_ms))
+#endif
+/** @endcond */
+
+/** Number of sensor to LED pairs. */
+#if defined(CONTROL_MAP_NODE)
+#define CONTROL_MAP_NUM_PAIRS DT_CHILD_NUM_STATUS_OKAY(CONTROL_MAP_NODE)
+#else
+#define CONTROL_MAP_NUM_PAIRS 1
+#endif
+
+/**
+ * @brief Invoke @p fn for each pair, in table order.
+ *
+ * @p fn is called as fn(id, sensor_node, led_node, period_step_ms,
+ * period_max_ms), where @c id is a token unique to the pair, usable to name
+ * per-pair objects.
+ *
+ * @param fn Macro to invoke.
+ * @param sep Separator (e.g. comma), in parentheses.
+ */
+#if defined(CONTROL_MAP_NODE)
+#define CONTROL_MAP_FOREACH_PAIR_SEP(fn, sep)                                  \
+	DT_FOREACH_CHILD_STATUS_OKAY_SEP_VARGS(CONTROL_MAP_NODE,               \
+					       CONTROL_MAP_PAIR_EXPAND, sep,   \
+					       fn)
+#else
+#define CONTROL_MAP_FOREACH_PAIR_SEP(fn, sep)                                  \
+	fn(0, DT_NODELABEL(example_sensor), DT_NODELABEL(blink_led),           \
+	   CONTROL_MAP_DEFAULT_STEP_MS, CONTROL_MAP_DEFAULT_MAX_MS)
+#endif
+
+/** @brief Sensor to LED pair. */
+struct control_map_pair {
+	/** Proximity sensor. */
+	const struct device *sensor;
+	/** Blink LED. */
+	const struct device *led;
+	/** Blinking period decrement on each proximity edge. */
+	uint16_t period_step_ms;
+	/** Initial blinking period. */
+	uint16_t period_max_ms;
+	/** Sensor is marked zephyr,deferred-init. */
+	bool sensor_deferred;
+	/** LED is marked zephyr,deferred-init. */
+	bool led_deferred;
+};
+
+/**
+ * @brief Sample of all pairs, as published on @c control_map_sample_chan.
+ *
+ * Bit @c n of each mask is for pair @c n.
+ */
+struct control_map_sample {
+	/** Uptime of the control step, in milliseconds. */
+	int64_t uptime_ms;
+	/** Proximity level. */
+	edge_detect_word_t levels[EDGE_DETECT_WORDS(CONTROL_MAP_NUM_PAIRS)];
+	/** Pairs that went near in this step. */
+	edge_detect_word_t rising[EDGE_DETECT_WORDS(CONTROL_MAP_NUM_PAIRS)];
+	/** Pairs that went far in this step. */
+	edge_detect_word_t falling[EDGE_DETECT_WORDS(CONTROL_MAP_NUM_PAIRS)];
+};
+
+#if defined(CONFIG_CONTROL_MAP_ZBUS) || defined(__DOXYGEN__)
+/**
+ * @brief Channel carrying a @ref control_map_sample for every control step.
+ *
+ * Any number of listeners and subscribers can be attached with
+ * ZBUS_CHAN_ADD_OBS(). The sample is stored once in the channel, listeners
+ * access it in place with zbus_chan_const_msg(), and subscribers receive a
+ * reference to the channel in their queue and can do the same between
+ * zbus_chan_claim() and zbus_chan_finish().
+ */
+ZBUS_CHAN_DECLARE(control_map_sample_chan);
+#endif
+
+/** Pair table, generated from devicetree. */
+extern const struct control_map_pair control_map_pairs[CONTROL_MAP_NUM_PAIRS];
+
+/**
+ * @brief Initialize all pairs.
+ *
+ * Initializes deferred devices, checks that all devices are ready and turns
+ * all LEDs off.
+ *
+ * @retval 0 if successful.
+ * @retval -ENODEV if a device is not ready.
+ * @retval -errno Other negative errno code on failure.
+ */
+int control_map_init(void);
+
+/**
+ * @brief Run one control step for all pairs.
+ *
+ * @param levels Proximity level of each pair, bit @c n for pair @c n, with
+ * EDGE_DETECT_WORDS(CONTROL_MAP_NUM_PAIRS) words.
+ *
+ * @return Number of pairs whose period changed.
+ */
+size_t control_map_update(const edge_detect_word_t *levels);
+
+/**
+ * @brief Current blinking period of a pair.
+ *
+ * @param pair Pair index.
+ *
+ * @return Blinking period in milliseconds, 0 if not blinking.
+ */
+unsigned int control_map_period_ms(size_t pair);
+
+/** @} */
+
+#endif /* APP_LIB_CONTROL_MAP_H_ */
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_LIB_DEVICE_RESIDENCY_H_
+#define APP_LIB_DEVICE_RESIDENCY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/sys/slist.h>
+
+/**
+ * @defgroup lib_device_residency Device residency library
+ * @ingroup lib
+ * @{
+ *
+ * @brief Time spent by devices in the active and suspended states.
+ *
+ * Drivers embed a @ref device_residency in their data, register it at
+ * initialization and report each state change from their power management
+ * action callback. The time in the current state is accounted when the
+ * residency is read, so readings are exact at any time.
+ */
+
+/** @brief Residency of a device, see device_residency_get(). */
+struct device_residency_stats {
+	/** Time spent active, in microseconds. */
+	uint64_t active_us;
+	/** Time spent suspended, in microseconds. */
+	uint64_t suspended_us;
+	/** Number of resumes. */
+	uint32_t resumes;
+};
+
+/** @brief Residency state, embedded in driver data. */
+struct device_residency {
+	/** @cond INTERNAL_HIDDEN */
+	sys_snode_t node;
+	const struct device *dev;
+	bool active;
+	/* Times in system ticks */
+	int64_t since;
+	int64_t active_ticks;
+	int64_t suspended_ticks;
+	uint32_t resumes;
+	/** @endcond */
+};
+
+/**
+ * @brief Residency callback.
+ *
+ * @param dev Device.
+ * @param stats Residency of @p dev.
+ * @param user_data User data given to device_residency_foreach().
+ */
+typedef void (*device_residency_cb_t)(const struct device *dev,
+				      const struct device_residency_stats *stats,
+				      void *user_data);
+
+/**
+ * @brief Register the residency of a device.
+ *
+ * Called once, from the device initialization function.
+ *
+ * @param res Residency state.
+ * @param dev Device.
+ * @param active Initial state of the device.
+ */
+void device_residency_init(struct device_residency *res,
+			   const struct device *dev, bool active);
+
+/**
+ * @brief Report a state change.
+ *
+ * Reporting the current state again has no effect.
+ *
+ * @param res Residency state.
+ * @param active true once resumed, false once suspended.
+ */
+void device_residency_set(struct device_residency *res, bool active);
+
+/**
+ * @brief Get the residency of a device.
+ *
+ * @param dev Device.
+ * @param stats Residency since initialization.
+ *
+ * @retval 0 if successful.
+ * @retval -ENOENT if the device did not register its residency.
+ */
+int device_residency_get(const struct device *dev,
+			 struct device_residency_stats *stats);
+
+/**
+ * @brief Get the residency of every registered device.
+ *
+ * @param cb Callback invoked for each device.
+ * @param user_data User data passed to @p cb.
+ */
+void device_residency_foreach(device_residency_cb_t cb, void *user_data);
+
+/** @} */
+
+#endif /* APP_LIB_DEVICE_RESIDENCY_H_ */
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_LIB_EDGE_DETECT_H_
+#define APP_LIB_EDGE_DETECT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/sys/util.h>
+
+/**
+ * @defgroup lib_edge_detect Edge detection library
+ * @ingroup lib
+ * @{
+ *
+ * @brief Rising/falling edge detection over many digital inputs at once.
+ *
+ * Inputs are handled as packed bitmask snapshots, one bit per input, and all
+ * inputs of a word are processed with a handful of bitwise operations.
+ * Optionally, each input is filtered over the last N samples: the filtered
+ * level goes high when at least @c threshold samples are high, and low when
+ * at least @c threshold samples are low, keeping its value in between. With
+ * an odd N and a threshold of N/2 + 1 this is a plain majority vote, higher
+ * thresholds add hysteresis. Sample counts are kept bit-sliced, so the cost
+ * per word does not depend on the number of inputs it holds.
+ */
+
+#ifdef CONFIG_EDGE_DETECT_WORD_64
+/** Word holding the snapshot of up to @ref EDGE_DETECT_WORD_BITS inputs. */
+typedef uint64_t edge_detect_word_t;
+#else
+typedef uint32_t edge_detect_word_t;
+#endif
+
+/** Number of inputs held in a @ref edge_detect_word_t. */
+#define EDGE_DETECT_WORD_BITS (8U * sizeof(edge_detect_word_t))
+
+/** Number of words needed to hold @p num_inputs inputs. */
+#define EDGE_DETECT_WORDS(num_inputs)                                          \
+	DIV_ROUND_UP(num_inputs, EDGE_DETECT_WORD_BITS)
+
+/** Maximum filter depth (number of samples voting). */
+#define EDGE_DETECT_MAX_DEPTH 15U
+
+/** @brief Edge detector state. */
+struct edge_detect {
+	/** Filtered level of each input, @ref words words. */
+	edge_detect_word_t *level;
+	/** Last @ref depth samples, @ref depth x @ref words words. */
+	edge_detect_word_t *history;
+	/** Number of words per snapshot. */
+	size_t words;
+	/** Number of samples voting, 1 disables filtering. */
+	uint8_t depth;
+	/** Number of agreeing samples needed to change the filtered level. */
+	uint8_t threshold;
+	/** Index of the oldest sample in @ref history. */
+	uint8_t head;
+};
+
+/**
+ * @brief Statically define an edge detector.
+ *
+ * The detector starts with all inputs low, as after edge_detect_reset() with
+ * no initial level.
+ *
+ * @param _name Detector name.
+ * @param _num_inputs Number of inputs.
+ * @param _depth Number of samples voting (1 to @ref EDGE_DETECT_MAX_DEPTH).
+ * @param _threshold Number of agreeing samples needed to change the filtered
+ * level, from @p _depth / 2 + 1 to @p _depth.
+ */
+#define EDGE_DETECT_DEFINE(_name, _num_inputs, _depth, _threshold)            \
+	BUILD_ASSERT(((_depth) >= 1) && ((_depth) <= EDGE_DETECT_MAX_DEPTH),   \
+		     "invalid edge detector depth");                           \
+	BUILD_ASSERT(((_threshold) > ((_depth) / 2)) &&                        \
+			     ((_threshold) <= (_depth)),                       \
+		     "invalid edge detector threshold");                       \
+	static edge_detect_word_t                                              \
+		_name##_level[EDGE_DETECT_WORDS(_num_inputs)];                 \
+	static edge_detect_word_t                                              \
+		_name##_history[(_depth) * EDGE_DETECT_WORDS(_num_inputs)];    \
+	static struct edge_detect _name = {                                    \
+		.level = _name##_level,                                        \
+		.history = _name##_history,                                    \
+		.words = EDGE_DETECT_WORDS(_num_inputs),                       \
+		.depth = (_depth),                                             \
+		.threshold = (_threshold),                                     \
+	}
+
+/**
+ * @brief Reset a detector to a known level.
+ *
+ * All samples of the filter history are set to @p initial, so no edge is
+ * reported until inputs move away from it.
+ *
+ * @param ed Edge detector.
+ * @param initial Initial level of the inputs, or NULL for all low.
+ */
+void edge_detect_reset(struct edge_detect *ed,
+		       const edge_detect_word_t *initial);
+
+/**
+ * @brief Feed a new snapshot and compute edge masks.
+ *
+ * Any of the output masks can be NULL if not needed. Bits of unused inputs
+ * in the last word must be kept at the same value in every snapshot.
+ *
+ * @param ed Edge detector.
+ * @param sample Snapshot of the inputs, @ref edge_detect.words words.
+ * @param rising Inputs whose filtered level went high.
+ * @param falling Inputs whose filtered level went low.
+ * @param changed Inputs whose filtered level changed.
+ *
+ * @retval true if any input changed.
+ * @retval false otherwise.
+ */
+bool edge_detect_update(struct edge_detect *ed,
+			const edge_detect_word_t *sample,
+			edge_detect_word_t *rising, edge_detect_word_t *falling,
+			edge_detect_word_t *changed);
+
+/**
+ * @brief Filtered level of an input.
+ *
+ * @param ed Edge detector.
+ * @param input Input index.
+ *
+ * @return Filtered level of @p input (0 or 1).
+ */
+static inline int edge_detect_level(const struct edge_detect *ed, size_t input)
+{
+	return (int)((ed->level[input / EDGE_DETECT_WORD_BITS] >>
+		      (input % EDGE_DETECT_WORD_BITS)) & 1U);
+}
+
+/**
+ * @brief Sample whole GPIO ports into a snapshot.
+ *
+ * Reads the raw input value of each port with a single port access and packs
+ * the results, port after port, into @p sample. Each port takes
+ * @c GPIO_MAX_PINS_PER_PORT bits, so input @c n is pin
+ * @c n % GPIO_MAX_PINS_PER_PORT of port @c n / GPIO_MAX_PINS_PER_PORT.
+ *
+ * @param ports GPIO controllers to sample.
+ * @param num_ports Number of entries in @p ports.
+ * @param sample Snapshot to fill, at least
+ * EDGE_DETECT_WORDS(@p num_ports * GPIO_MAX_PINS_PER_PORT) words.
+ *
+ * @retval 0 if successful.
+ * @retval -errno Negative errno code if a port could not be read.
+ */
+int edge_detect_sample_ports(const struct device *const *ports,
+			     size_t num_ports, edge_detect_word_t *sample);
+
+/** @} */
+
+#endif /* APP_LIB_EDGE_DETECT_H_ */
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_LIB_EVENT_LOG_H_
+#define APP_LIB_EVENT_LOG_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @defgroup lib_event_log Event log library
+ * @ingroup lib
+ * @{
+ *
+ * @brief Persistent history of proximity events on a littlefs file system.
+ *
+ * Events are delta-encoded into a RAM page of CONFIG_EVENT_LOG_PAGE_SIZE
+ * bytes. Full pages are written whole, from a dedicated work queue, to the
+ * files @c log0 to @c log<N-1> of the log directory, each holding
+ * CONFIG_EVENT_LOG_FILE_PAGES pages. When the last file is full, the oldest
+ * one is overwritten. A second RAM page takes events while the first one is
+ * written, so adding an event never waits for flash.
+ *
+ * Event timestamps are system uptimes, and must not go backwards. The 32-bit
+ * uptime may wrap around, timestamps are compared modulo 2^32. As uptimes
+ * restart at each boot, pages are tagged with a boot number, incremented by
+ * each event_log_init() call finding a previous log, and queries select
+ * one boot.
+ */
+
+/** @brief Event types. */
+enum event_log_type {
+	/** Proximity edge, value is 1 (near) or 0 (far). */
+	EVENT_LOG_EDGE = 0,
+	/** LED period change, value is the period in milliseconds. */
+	EVENT_LOG_PERIOD = 1,
+};
+
+/** @brief Event. */
+struct event_log_event {
+	/** System uptime, in milliseconds. */
+	uint32_t uptime_ms;
+	/** Pair index. */
+	uint16_t id;
+	/** Event type, see @ref event_log_type. */
+	uint8_t type;
+	/** Event value. */
+	int32_t value;
+};
+
+/** @brief Counters since initialization. */
+struct event_log_stats {
+	/** Events added. */
+	uint32_t events;
+	/** Events dropped to full RAM pages or to page write errors. */
+	uint32_t dropped;
+	/** Bytes of encoded events. */
+	uint32_t encoded_bytes;
+	/** Pages written to files, including partial pages on sync. */
+	uint32_t pages_written;
+	/** Bytes written to files. */
+	uint32_t bytes_written;
+};
+
+/**
+ * @brief Query callback.
+ *
+ * @param event Event.
+ * @param user_data User data given to event_log_query().
+ *
+ * @return true to continue, false to stop the query.
+ */
+typedef bool (*event_log_cb_t)(const struct event_log_event *event,
+			       void *user_data);
+
+/**
+ * @brief Initialize the log.
+ *
+ * Scans existing log files, so that new events are appended after the most
+ * recent page, in a new boot.
+ *
+ * @param dir Log directory on a mounted littlefs file system, kept by
+ * reference.
+ *
+ * @retval 0 if successful.
+ * @retval -errno Negative errno code on failure.
+ */
+int event_log_init(const char *dir);
+
+/**
+ * @brief Add an event.
+ *
+ * Must not be called from interrupts.
+ *
+ * @param event Event.
+ *
+ * @retval 0 if successful.
+ * @retval -EAGAIN if the log is not initialized.
+ * @retval -EINVAL if the event is older than the previous one, or if its
+ * type is unknown.
+ * @retval -ENOBUFS if both RAM pages are full, the event is dropped.
+ */
+int event_log_add(const struct event_log_event *event);
+
+/**
+ * @brief Write buffered events to flash.
+ *
+ * Writes pending full pages and the current partial page, which is written
+ * again at the same place once it holds more events.
+ *
+ * @retval 0 if successful.
+ * @retval -errno Negative errno code on failure.
+ */
+int event_log_sync(void);
+
+/**
+ * @brief Get the boot number of the events added since initialization.
+ *
+ * @return 0 for a new log, one more than the boot of the most recent page
+ * found by event_log_init() otherwise.
+ */
+uint16_t event_log_boot(void);
+
+/**
+ * @brief Get the events of a boot in a time range, oldest first.
+ *
+ * Events both in files and in RAM are returned. Pages of other boots or
+ * outside of the range are skipped from their header, without decoding
+ * their events. After the uptime wrapped, events on both sides of the wrap
+ * whose raw timestamp is in the range are returned, in the order added.
+ *
+ * @param boot Boot of the events, see event_log_boot().
+ * @param from_ms Start of the range, inclusive.
+ * @param to_ms End of the range, inclusive.
+ * @param cb Callback invoked for each event.
+ * @param user_data User data passed to @p cb.
+ *
+ * @return Number of events passed to @p cb, or a negative errno code.
+ */
+int event_log_query(uint16_t boot, uint32_t from_ms, uint32_t to_ms,
+		    event_log_cb_t cb, void *user_data);
+
+/**
+ * @brief Get the log counters.
+ *
+ * @param stats Counters.
+ */
+void event_log_stats_get(struct event_log_stats *stats);
+
+/** @} */
+
+#endif /* APP_LIB_EVENT_LOG_H_ */
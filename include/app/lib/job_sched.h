@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_LIB_JOB_SCHED_H_
+#define APP_LIB_JOB_SCHED_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+
+/**
+ * @defgroup lib_job_sched Job scheduler library
+ * @ingroup lib
+ * @{
+ *
+ * @brief Periodic jobs run cooperatively from a single thread.
+ *
+ * Jobs are run by the thread calling job_sched_run(), one after the other,
+ * in earliest-deadline-first order. A job becomes due every period, and its
+ * deadline is its due time plus its slack. The scheduler only wakes up when
+ * the earliest deadline is reached, and then runs every job that is already
+ * due, so jobs due close to each other share a single wakeup. A job with no
+ * slack is run exactly when due.
+ */
+
+struct job_sched_job;
+
+/**
+ * @brief Job handler.
+ *
+ * Runs in the scheduler thread. Use CONTAINER_OF() on @p job to get to the
+ * job context.
+ *
+ * @param job Job being run.
+ */
+typedef void (*job_sched_handler_t)(struct job_sched_job *job);
+
+/** @brief Periodic job. */
+struct job_sched_job {
+	/** @cond INTERNAL_HIDDEN */
+	sys_dnode_t node;
+	int64_t due;
+	int64_t deadline;
+	/** @endcond */
+	/** Handler. */
+	job_sched_handler_t handler;
+	/** Period in milliseconds, 0 for a one-shot job. */
+	uint32_t period_ms;
+	/** Allowed lateness in milliseconds. */
+	uint32_t slack_ms;
+	/** Number of times the job ran. */
+	uint32_t runs;
+	/** Number of periods skipped because the job ran too late. */
+	uint32_t overruns;
+};
+
+/** @brief Scheduler statistics. */
+struct job_sched_stats {
+	/**
+	 * Number of times the scheduler thread woke up for a deadline, not
+	 * counting early wakeups from job_sched_add() or job_sched_stop().
+	 */
+	uint32_t wakeups;
+	/** Number of job runs. */
+	uint32_t runs;
+};
+
+/**
+ * @brief Statically initialize a job.
+ *
+ * @param _handler Job handler.
+ * @param _period_ms Period in milliseconds, 0 for a one-shot job.
+ * @param _slack_ms Allowed lateness in milliseconds.
+ */
+#define JOB_SCHED_JOB_INITIALIZER(_handler, _period_ms, _slack_ms)             \
+	{                                                                      \
+		.handler = (_handler),                                         \
+		.period_ms = (_period_ms),                                     \
+		.slack_ms = (_slack_ms),                                       \
+	}
+
+/**
+ * @brief Initialize a job.
+ *
+ * @param job Job.
+ * @param handler Job handler.
+ * @param period_ms Period in milliseconds, 0 for a one-shot job.
+ * @param slack_ms Allowed lateness in milliseconds.
+ */
+void job_sched_job_init(struct job_sched_job *job, job_sched_handler_t handler,
+			uint32_t period_ms, uint32_t slack_ms);
+
+/**
+ * @brief Schedule a job.
+ *
+ * Can be called from any thread, including from job handlers.
+ *
+ * @param job Job.
+ * @param delay_ms Delay before the job is first due, in milliseconds.
+ *
+ * @retval 0 if successful.
+ * @retval -EALREADY if the job is already scheduled.
+ */
+int job_sched_add(struct job_sched_job *job, uint32_t delay_ms);
+
+/**
+ * @brief Cancel a job.
+ *
+ * Can be called from any thread, including from job handlers.
+ *
+ * @param job Job.
+ *
+ * @retval 0 if successful.
+ * @retval -EALREADY if the job is not scheduled.
+ */
+int job_sched_remove(struct job_sched_job *job);
+
+/**
+ * @brief Run jobs from the calling thread.
+ *
+ * Returns once job_sched_stop() is called.
+ */
+void job_sched_run(void);
+
+/**
+ * @brief Make job_sched_run() return.
+ *
+ * Jobs stay scheduled, and are run again on the next job_sched_run() call.
+ */
+void job_sched_stop(void);
+
+/**
+ * @brief Get scheduler statistics.
+ *
+ * @param stats Statistics since boot.
+ */
+void job_sched_stats_get(struct job_sched_stats *stats);
+
+/** @} */
+
+#endif /* APP_LIB_JOB_SCHED_H_ */
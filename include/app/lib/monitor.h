@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_LIB_MONITOR_H_
+#define APP_LIB_MONITOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+/**
+ * @defgroup lib_monitor Runtime monitor library
+ * @ingroup lib
+ * @{
+ *
+ * @brief Periodic thread runtime, CPU load and stack usage reports.
+ *
+ * The monitor samples the thread runtime statistics every
+ * CONFIG_MONITOR_PERIOD_MS milliseconds and reports, for each thread, the
+ * share of CPU time used during the last period and the stack high-water
+ * mark, together with the idle share. Reports are compact binary records
+ * made of a @ref monitor_record_header followed by
+ * @ref monitor_record_header.num_threads @ref monitor_record_thread entries,
+ * all little-endian. Time spent in ISRs is accounted to the interrupted
+ * thread.
+ */
+
+/** Size of thread names in reports, NUL terminator included. */
+#define MONITOR_THREAD_NAME_LEN 8U
+
+/** @brief Report header. */
+struct monitor_record_header {
+	/** System uptime at the end of the period, in milliseconds. */
+	uint32_t uptime_ms;
+	/** Idle share of the period, in per mille. */
+	uint16_t idle_permille;
+	/** Number of thread entries following the header. */
+	uint8_t num_threads;
+	/** Reserved, set to 0. */
+	uint8_t reserved;
+} __packed;
+
+/** @brief Report thread entry. */
+struct monitor_record_thread {
+	/** Thread name, truncated, padded and terminated with NUL. */
+	char name[MONITOR_THREAD_NAME_LEN];
+	/** CPU share of the thread over the period, in per mille. */
+	uint16_t cpu_permille;
+	/** Stack high-water mark, in bytes. */
+	uint16_t stack_used;
+	/** Stack size, in bytes. */
+	uint16_t stack_size;
+} __packed;
+
+/**
+ * @brief Report callback.
+ *
+ * Called from the system work queue once per period.
+ *
+ * @param record Binary report record.
+ * @param len Length of @p record in bytes.
+ * @param user_data User data given to monitor_start().
+ */
+typedef void (*monitor_report_cb_t)(const void *record, size_t len,
+				    void *user_data);
+
+/**
+ * @brief Start periodic reports.
+ *
+ * @param cb Report callback.
+ * @param user_data User data passed to @p cb.
+ *
+ * @retval 0 if successful.
+ * @retval -EALREADY if the monitor is already running.
+ */
+int monitor_start(monitor_report_cb_t cb, void *user_data);
+
+/** @brief Stop periodic reports. */
+void monitor_stop(void);
+
+/** @} */
+
+#endif /* APP_LIB_MONITOR_H_ */
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_LIB_RETAINED_RING_H_
+#define APP_LIB_RETAINED_RING_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @defgroup lib_retained_ring Retained ring library
+ * @ingroup lib
+ * @{
+ *
+ * @brief Ring of recent events kept in RAM across warm reboots.
+ *
+ * The ring holds the last CONFIG_RETAINED_RING_LEN entries, in a
+ * @c __noinit RAM region that is not cleared by warm reboots. Each entry
+ * carries a sequence number and a CRC-8, so that entries torn by a reset are
+ * ignored, and the region is only trusted if its header checksum matches.
+ * Recording an entry is a few stores and a CRC-8 over 15 bytes, from any
+ * context, and nothing is ever written to flash.
+ */
+
+/** @brief Entry types. */
+enum retained_ring_type {
+	/** Proximity edge, id is the pair, value is 1 (near) or 0 (far). */
+	RETAINED_RING_EDGE = 0,
+	/** LED period change, id is the pair, value is the period in ms. */
+	RETAINED_RING_PERIOD = 1,
+	/** Loop latency, id is the loop, value is the latency in us. */
+	RETAINED_RING_LATENCY = 2,
+};
+
+/** @brief Ring entry. */
+struct retained_ring_entry {
+	/** Sequence number, increasing across boots. */
+	uint32_t seq;
+	/** Uptime when recorded, in milliseconds. */
+	uint32_t uptime_ms;
+	/** Value. */
+	int32_t value;
+	/** Identifier. */
+	uint16_t id;
+	/** Type, see @ref retained_ring_type. */
+	uint8_t type;
+	/** @cond INTERNAL_HIDDEN */
+	uint8_t crc;
+	/** @endcond */
+};
+
+/**
+ * @brief Entry callback.
+ *
+ * @param entry Entry.
+ * @param user_data User data given to retained_ring_foreach_previous().
+ */
+typedef void (*retained_ring_cb_t)(const struct retained_ring_entry *entry,
+				   void *user_data);
+
+/**
+ * @brief Validate the ring left by the previous boot.
+ *
+ * Must be called before recording, early at boot. If the ring checksum does
+ * not match, as after a power-on reset, the ring is cleared. Otherwise its
+ * valid entries are kept, and recording resumes after the most recent one.
+ * Calling it again acts as a warm reboot.
+ *
+ * @return Number of entries kept from previous boots.
+ */
+int retained_ring_init(void);
+
+/**
+ * @brief Record an entry.
+ *
+ * Can be called from any context. Does nothing before retained_ring_init().
+ *
+ * @param type Entry type.
+ * @param id Identifier.
+ * @param value Value.
+ */
+void retained_ring_record(enum retained_ring_type type, uint16_t id,
+			  int32_t value);
+
+/**
+ * @brief Get the entries recorded before the last retained_ring_init().
+ *
+ * Entries are passed oldest first. They are overwritten by new entries, so
+ * they are best read right after retained_ring_init().
+ *
+ * @param cb Callback invoked for each entry.
+ * @param user_data User data passed to @p cb.
+ *
+ * @return Number of entries passed to @p cb.
+ */
+int retained_ring_foreach_previous(retained_ring_cb_t cb, void *user_data);
+
+/**
+ * @brief Get the number of warm boots the ring went through.
+ *
+ * @return 0 after a power-on reset or retained_ring_clear(), incremented by
+ * each retained_ring_init() call finding a valid ring.
+ */
+uint32_t retained_ring_boots(void);
+
+/**
+ * @brief Clear the ring.
+ *
+ * Drops all entries, for instance once they have been reported, and resets
+ * the boot counter.
+ */
+void retained_ring_clear(void);
+
+/** @} */
+
+#endif /* APP_LIB_RETAINED_RING_H_ */
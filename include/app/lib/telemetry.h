@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_LIB_TELEMETRY_H_
+#define APP_LIB_TELEMETRY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @defgroup lib_telemetry Telemetry library
+ * @ingroup lib
+ * @{
+ *
+ * @brief Batched CBOR telemetry records sent over an asynchronous UART.
+ *
+ * Recording only copies a few words into a queue, so it can be done from the
+ * control loop or from interrupts. Queued records are encoded in batches
+ * from the system work queue, into one of two buffers, and sent with the
+ * UART asynchronous API while the next batch is encoded. The UART is the
+ * @c app,telemetry-uart chosen node, or @c zephyr,console if not set.
+ *
+ * On the wire, each batch is a frame made of @ref TELEMETRY_FRAME_MAGIC, the
+ * CBOR payload length (16-bit little-endian) and the CBOR payload:
+ *
+ *     [seq, base_ms, dropped, [record, ...]]
+ *
+ * where @c seq is the batch sequence number, @c base_ms the uptime of the
+ * first record, @c dropped the number of records lost to a full queue since
+ * the previous batch, and each record is [type, delta_ms, id, values...]
+ * with @c delta_ms relative to @c base_ms. See scripts/telemetry_decode.py.
+ */
+
+/** First byte of every frame. */
+#define TELEMETRY_FRAME_MAGIC 0xCBU
+
+/** @brief Record types. */
+enum telemetry_type {
+	/** Proximity edge, id is the pair, value is 1 (near) or 0 (far). */
+	TELEMETRY_TYPE_EDGE = 0,
+	/** LED period change, id is the pair, value is the period in ms. */
+	TELEMETRY_TYPE_PERIOD = 1,
+	/** Statistics, id is the source, values are source specific. */
+	TELEMETRY_TYPE_STATS = 2,
+};
+
+/**
+ * @brief Record a proximity edge.
+ *
+ * @param pair Pair index.
+ * @param near true if the target got near, false if it went away.
+ *
+ * @retval 0 if successful.
+ * @retval -ENOBUFS if the queue is full, the record is counted as dropped.
+ */
+int telemetry_edge(uint16_t pair, bool near);
+
+/**
+ * @brief Record a blinking period change.
+ *
+ * @param pair Pair index.
+ * @param period_ms New period in milliseconds, 0 if not blinking.
+ *
+ * @retval 0 if successful.
+ * @retval -ENOBUFS if the queue is full, the record is counted as dropped.
+ */
+int telemetry_period(uint16_t pair, uint32_t period_ms);
+
+/**
+ * @brief Record statistics.
+ *
+ * @param source Source identifier, defined by the application.
+ * @param values Values.
+ * @param count Number of values, at most CONFIG_TELEMETRY_MAX_VALUES.
+ *
+ * @retval 0 if successful.
+ * @retval -EINVAL if @p count is too large.
+ * @retval -ENOBUFS if the queue is full, the record is counted as dropped.
+ */
+int telemetry_stats(uint16_t source, const int32_t *values, size_t count);
+
+/**
+ * @brief Encode and send the queued records now.
+ *
+ * Records are otherwise sent at most CONFIG_TELEMETRY_FLUSH_MS after they
+ * are queued, or as soon as a full batch is queued.
+ */
+void telemetry_flush(void);
+
+/** @} */
+
+#endif /* APP_LIB_TELEMETRY_H_ */
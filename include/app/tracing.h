@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_TRACING_H_
+#define APP_TRACING_H_
+
+#include <stdint.h>
+
+#if defined(CONFIG_EXAMPLE_TRACING)
+#include <zephyr/tracing/tracing.h>
+#endif
+
+/**
+ * @defgroup app_tracing Trace points
+ * @{
+ *
+ * @brief Trace points of the example application and its drivers.
+ *
+ * Trace points are emitted as named events of the Zephyr tracing subsystem,
+ * so they are recorded by any tracing backend (e.g. CTF) alongside kernel
+ * events. Event names are limited to 20 characters by the CTF format. The
+ * `west trace-stats` command turns a CTF trace into per-stage latency
+ * statistics.
+ */
+
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_EXAMPLE_TRACING)
+#define APP_TRACE(name, arg0, arg1)                                            \
+	sys_trace_named_event(name, (uint32_t)(arg0), (uint32_t)(arg1))
+#else
+#define APP_TRACE(name, arg0, arg1)                                            \
+	do {                                                                   \
+	} while (false)
+#endif
+/** @endcond */
+
+/** @brief Sensor sample fetch started on @p dev. */
+#define APP_TRACE_SENSOR_FETCH_START(dev)                                      \
+	APP_TRACE("sensor_fetch_start", (uintptr_t)(dev), 0)
+
+/** @brief Sensor sample fetch on @p dev completed with @p state. */
+#define APP_TRACE_SENSOR_FETCH_END(dev, state)                                 \
+	APP_TRACE("sensor_fetch_end", (uintptr_t)(dev), state)
+
+/** @brief Control loop detected a proximity edge on pair @p pair. */
+#define APP_TRACE_EDGE_DETECTED(pair) APP_TRACE("edge_detected", pair, 0)
+
+/** @brief Control loop changed the LED period to @p period_ms. */
+#define APP_TRACE_PERIOD_CHANGE(period_ms)                                     \
+	APP_TRACE("period_change", period_ms, 0)
+
+/** @brief LED of blink device @p dev toggled. */
+#define APP_TRACE_BLINK_TOGGLE(dev)                                            \
+	APP_TRACE("blink_toggle", (uintptr_t)(dev), 0)
+
+/** @} */
+
+#endif /* APP_TRACING_H_ */
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+
+#include <app/lib/boot_profile.h>
+
+LOG_MODULE_REGISTER(boot_profile, CONFIG_BOOT_PROFILE_LOG_LEVEL);
+
+static const char *const phase_names[] = {
+	[BOOT_PROFILE_KERNEL] = "kernel",
+	[BOOT_PROFILE_SENSOR_INIT] = "sensor init",
+	[BOOT_PROFILE_SENSOR_READY] = "sensor ready",
+	[BOOT_PROFILE_BLINK_INIT] = "blink init",
+	[BOOT_PROFILE_BLINK_READY] = "blink ready",
+	[BOOT_PROFILE_MAIN] = "main",
+	[BOOT_PROFILE_FIRST_SAMPLE] = "first sample",
+};
+
+BUILD_ASSERT(ARRAY_SIZE(phase_names) == BOOT_PROFILE_NUM_PHASES);
+
+static uint32_t timestamps[BOOT_PROFILE_NUM_PHASES];
+static ATOMIC_DEFINE(marked, BOOT_PROFILE_NUM_PHASES);
+
+static void boot_profile_report(struct k_work *work)
+{
+	uint32_t us;
+
+	ARG_UNUSED(work);
+
+	for (int i = 0; i < BOOT_PROFILE_NUM_PHASES; i++) {
+		if (boot_profile_get_us(i, &us) == 0) {
+			LOG_INF("%-12s %8u us", phase_names[i], us);
+		} else {
+			LOG_INF("%-12s %8s", phase_names[i], "-");
+		}
+	}
+}
+
+static K_WORK_DEFINE(report_work, boot_profile_report);
+
+void boot_profile_mark(enum boot_profile_phase phase)
+{
+	uint32_t now = k_cycle_get_32();
+
+	if (atomic_test_and_set_bit(marked, phase)) {
+		return;
+	}
+
+	timestamps[phase] = now;
+
+	/* Report off the hot path once the profile is complete */
+	if (phase == BOOT_PROFILE_FIRST_SAMPLE) {
+		(void)k_work_submit(&report_work);
+	}
+}
+
+int boot_profile_get_us(enum boot_profile_phase phase, uint32_t *us)
+{
+	if (!atomic_test_bit(marked, phase)) {
+		return -ENODATA;
+	}
+
+	*us = k_cyc_to_us_floor32(timestamps[phase]);
+
+	return 0;
+}
+
+static int boot_profile_init(void)
+{
+	boot_profile_mark(BOOT_PROFILE_KERNEL);
+
+	return 0;
+}
+
+SYS_INIT(boot_profile_init, POST_KERNEL, 0);
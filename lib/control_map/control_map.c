@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#ifdef CONFIG_CONTROL_MAP_ZBUS
+#include <zephyr/zbus/zbus.h>
+#endif
+
+#include <app/drivers/blink.h>
+#include <app/lib/control_map.h>
+#include <app/lib/edge_detect.h>
+#include <app/lib/event_log.h>
+#include <app/lib/retained_ring.h>
+#include <app/lib/telemetry.h>
+#include <app/tracing.h>
+
+LOG_MODULE_REGISTER(control_map, CONFIG_CONTROL_MAP_LOG_LEVEL);
+
+#define CONTROL_MAP_PAIR_INIT(id, sensor_node, led_node, step, max)            \
+	{                                                                      \
+		.sensor = DEVICE_DT_GET(sensor_node),                          \
+		.led = DEVICE_DT_GET(led_node),                                \
+		.period_step_ms = (step),                                      \
+		.period_max_ms = (max),                                        \
+		.sensor_deferred = DT_PROP(sensor_node, zephyr_deferred_init), \
+		.led_deferred = DT_PROP(led_node, zephyr_deferred_init),       \
+	}
+
+const struct control_map_pair control_map_pairs[CONTROL_MAP_NUM_PAIRS] = {
+	CONTROL_MAP_FOREACH_PAIR_SEP(CONTROL_MAP_PAIR_INIT, (,))
+};
+
+static unsigned int periods[CONTROL_MAP_NUM_PAIRS];
+
+EDGE_DETECT_DEFINE(prox_edge, CONTROL_MAP_NUM_PAIRS, 1, 1);
+
+static int device_setup(const struct device *dev, bool deferred)
+{
+	int ret;
+
+	if (deferred) {
+		ret = device_init(dev);
+		/* Devices shared by several pairs are initialized once */
+		if ((ret < 0) && (ret != -EALREADY)) {
+			return ret;
+		}
+	}
+
+	return device_is_ready(dev) ? 0 : -ENODEV;
+}
+
+int control_map_init(void)
+{
+	int ret;
+
+	for (size_t i = 0U; i < CONTROL_MAP_NUM_PAIRS; i++) {
+		const struct control_map_pair *pair = &control_map_pairs[i];
+
+		ret = device_setup(pair->sensor, pair->sensor_deferred);
+		if (ret < 0) {
+			LOG_ERR("Pair %zu: sensor not ready (%d)", i, ret);
+			return ret;
+		}
+
+		ret = device_setup(pair->led, pair->led_deferred);
+		if (ret < 0) {
+			LOG_ERR("Pair %zu: LED not ready (%d)", i, ret);
+			return ret;
+		}
+
+		ret = blink_off(pair->led);
+		if (ret < 0) {
+			LOG_ERR("Pair %zu: could not turn off LED (%d)", i, ret);
+			return ret;
+		}
+
+		periods[i] = pair->period_max_ms;
+	}
+
+	edge_detect_reset(&prox_edge, NULL);
+
+	LOG_INF("%u pairs, %zu bytes ROM, %zu bytes RAM",
+		(unsigned int)CONTROL_MAP_NUM_PAIRS, sizeof(control_map_pairs),
+		sizeof(periods) + 2U * prox_edge.words * sizeof(edge_detect_word_t));
+
+	return 0;
+}
+
+#ifdef CONFIG_CONTROL_MAP_EVENT_LOG
+static void control_map_log(enum event_log_type type, size_t i, int32_t value)
+{
+	const struct event_log_event event = {
+		.uptime_ms = k_uptime_get_32(),
+		.id = (uint16_t)i,
+		.type = type,
+		.value = value,
+	};
+
+	(void)event_log_add(&event);
+}
+#endif /* CONFIG_CONTROL_MAP_EVENT_LOG */
+
+static void control_map_step(size_t i)
+{
+	const struct control_map_pair *pair = &control_map_pairs[i];
+
+	APP_TRACE_EDGE_DETECTED(i);
+
+	if (periods[i] == 0U) {
+		periods[i] = pair->period_max_ms;
+	} else if (periods[i] > pair->period_step_ms) {
+		periods[i] -= pair->period_step_ms;
+	} else {
+		periods[i] = 0U;
+	}
+
+	APP_TRACE_PERIOD_CHANGE(periods[i]);
+
+#ifdef CONFIG_CONTROL_MAP_TELEMETRY
+	(void)telemetry_period(i, periods[i]);
+#else
+	LOG_INF("Proximity detected on pair %zu, setting LED period to %u ms", i,
+		periods[i]);
+#endif
+#ifdef CONFIG_CONTROL_MAP_EVENT_LOG
+	control_map_log(EVENT_LOG_PERIOD, i, (int32_t)periods[i]);
+#endif
+#ifdef CONFIG_CONTROL_MAP_RETAINED_RING
+	retained_ring_record(RETAINED_RING_PERIOD, i, (int32_t)periods[i]);
+#endif
+	(void)blink_set_period_ms(pair->led, periods[i]);
+}
+
+#if defined(CONFIG_CONTROL_MAP_TELEMETRY) ||                                   \
+	defined(CONFIG_CONTROL_MAP_EVENT_LOG) ||                               \
+	defined(CONFIG_CONTROL_MAP_RETAINED_RING)
+#define CONTROL_MAP_RECORD_EDGES 1
+
+static void control_map_record_edges(const struct control_map_sample *sample)
+{
+	for (size_t w = 0U; w < ARRAY_SIZE(sample->rising); w++) {
+		edge_detect_word_t edges = sample->rising[w] | sample->falling[w];
+
+		while (edges != 0U) {
+			size_t bit = __builtin_ctzll(edges);
+			size_t i = w * EDGE_DETECT_WORD_BITS + bit;
+			bool near = (sample->rising[w] >> bit) & 1U;
+
+			edges &= edges - 1U;
+#ifdef CONFIG_CONTROL_MAP_TELEMETRY
+			(void)telemetry_edge(i, near);
+#endif
+#ifdef CONFIG_CONTROL_MAP_EVENT_LOG
+			control_map_log(EVENT_LOG_EDGE, i, near ? 1 : 0);
+#endif
+#ifdef CONFIG_CONTROL_MAP_RETAINED_RING
+			retained_ring_record(RETAINED_RING_EDGE, i, near ? 1 : 0);
+#endif
+		}
+	}
+}
+#endif /* CONTROL_MAP_RECORD_EDGES */
+
+#ifdef CONFIG_CONTROL_MAP_ZBUS
+ZBUS_CHAN_DEFINE(control_map_sample_chan, struct control_map_sample, NULL,
+		 NULL, ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+
+static void control_map_publish(struct control_map_sample *sample)
+{
+	int ret;
+
+	/* Observers are added with ZBUS_CHAN_ADD_OBS() by each consumer, and
+	 * read the single channel copy in place.
+	 */
+	ret = zbus_chan_pub(&control_map_sample_chan, sample, K_NO_WAIT);
+	if (ret < 0) {
+		LOG_DBG("Sample not published (%d)", ret);
+	}
+}
+#endif /* CONFIG_CONTROL_MAP_ZBUS */
+
+size_t control_map_update(const edge_detect_word_t *levels)
+{
+	struct control_map_sample sample;
+	edge_detect_word_t *rising = sample.rising;
+	size_t changes = 0U;
+	bool changed;
+
+	changed = edge_detect_update(&prox_edge, levels, sample.rising,
+				     sample.falling, NULL);
+
+#ifdef CONFIG_CONTROL_MAP_ZBUS
+	sample.uptime_ms = k_uptime_get();
+	memcpy(sample.levels, levels, sizeof(sample.levels));
+	control_map_publish(&sample);
+#endif
+
+	if (!changed) {
+		return 0U;
+	}
+
+#ifdef CONTROL_MAP_RECORD_EDGES
+	control_map_record_edges(&sample);
+#endif
+
+	for (size_t w = 0U; w < ARRAY_SIZE(sample.rising); w++) {
+		while (rising[w] != 0U) {
+			size_t bit = __builtin_ctzll(rising[w]);
+
+			rising[w] &= rising[w] - 1U;
+			control_map_step(w * EDGE_DETECT_WORD_BITS + bit);
+			changes++;
+		}
+	}
+
+	return changes;
+}
+
+unsigned int control_map_period_ms(size_t pair)
+{
+	__ASSERT_NO_MSG(pair < CONTROL_MAP_NUM_PAIRS);
+
+	return periods[pair];
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/slist.h>
+
+#include <app/lib/device_residency.h>
+
+/* Only appended to, from device initialization */
+static sys_slist_t residencies = SYS_SLIST_STATIC_INIT(&residencies);
+static struct k_spinlock lock;
+
+void device_residency_init(struct device_residency *res,
+			   const struct device *dev, bool active)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lock);
+
+	res->dev = dev;
+	res->active = active;
+	res->since = k_uptime_ticks();
+	res->active_ticks = 0;
+	res->suspended_ticks = 0;
+	res->resumes = 0U;
+
+	sys_slist_append(&residencies, &res->node);
+
+	k_spin_unlock(&lock, key);
+}
+
+void device_residency_set(struct device_residency *res, bool active)
+{
+	k_spinlock_key_t key;
+	int64_t now;
+
+	key = k_spin_lock(&lock);
+
+	if (active != res->active) {
+		now = k_uptime_ticks();
+
+		if (res->active) {
+			res->active_ticks += now - res->since;
+		} else {
+			res->suspended_ticks += now - res->since;
+			res->resumes++;
+		}
+
+		res->active = active;
+		res->since = now;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+static void residency_read(struct device_residency *res,
+			   struct device_residency_stats *stats)
+{
+	int64_t active_ticks;
+	int64_t suspended_ticks;
+	k_spinlock_key_t key;
+	int64_t current;
+
+	key = k_spin_lock(&lock);
+
+	/* Time in the current state, not accounted yet */
+	current = k_uptime_ticks() - res->since;
+	active_ticks = res->active_ticks + (res->active ? current : 0);
+	suspended_ticks = res->suspended_ticks + (res->active ? 0 : current);
+	stats->resumes = res->resumes;
+
+	k_spin_unlock(&lock, key);
+
+	stats->active_us = k_ticks_to_us_floor64(active_ticks);
+	stats->suspended_us = k_ticks_to_us_floor64(suspended_ticks);
+}
+
+int device_residency_get(const struct device *dev,
+			 struct device_residency_stats *stats)
+{
+	struct device_residency *res;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&residencies, res, node) {
+		if (res->dev == dev) {
+			residency_read(res, stats);
+			return 0;
+		}
+	}
+
+	return -ENOENT;
+}
+
+void device_residency_foreach(device_residency_cb_t cb, void *user_data)
+{
+	struct device_residency_stats stats;
+	struct device_residency *res;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&residencies, res, node) {
+		residency_read(res, &stats);
+		cb(res->dev, &stats, user_data);
+	}
+}
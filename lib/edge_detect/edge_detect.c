@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/sys/__assert.h>
+
+#include <app/lib/edge_detect.h>
+
+/* Bit planes needed to count up to EDGE_DETECT_MAX_DEPTH samples */
+#define NUM_PLANES 4U
+
+BUILD_ASSERT(EDGE_DETECT_MAX_DEPTH < BIT(NUM_PLANES));
+
+/*
+ * Per-bit "count >= k", where count is held bit-sliced in planes (plane i
+ * holds bit i of every input count). Walks k from its most significant bit,
+ * tracking inputs already known greater and inputs equal so far.
+ */
+static inline edge_detect_word_t count_ge(const edge_detect_word_t *planes,
+					  unsigned int k)
+{
+	edge_detect_word_t gt = 0U;
+	edge_detect_word_t eq = ~(edge_detect_word_t)0U;
+
+	for (int i = NUM_PLANES - 1; i >= 0; i--) {
+		if ((k & BIT(i)) != 0U) {
+			eq &= planes[i];
+		} else {
+			gt |= eq & planes[i];
+			eq &= ~planes[i];
+		}
+	}
+
+	return gt | eq;
+}
+
+static edge_detect_word_t filter_word(const struct edge_detect *ed, size_t w,
+				      edge_detect_word_t level)
+{
+	edge_detect_word_t planes[NUM_PLANES] = {0U};
+	edge_detect_word_t high, low;
+
+	/* Bit-sliced ripple-carry add of every sample into the counts */
+	for (size_t s = 0U; s < ed->depth; s++) {
+		edge_detect_word_t carry = ed->history[s * ed->words + w];
+
+		for (size_t i = 0U; (i < NUM_PLANES) && (carry != 0U); i++) {
+			edge_detect_word_t t = planes[i] & carry;
+
+			planes[i] ^= carry;
+			carry = t;
+		}
+	}
+
+	high = count_ge(planes, ed->threshold);
+	low = ~count_ge(planes, ed->depth - ed->threshold + 1U);
+
+	return high | (level & ~low);
+}
+
+void edge_detect_reset(struct edge_detect *ed,
+		       const edge_detect_word_t *initial)
+{
+	__ASSERT_NO_MSG((ed->depth >= 1U) &&
+			(ed->depth <= EDGE_DETECT_MAX_DEPTH));
+	__ASSERT_NO_MSG((ed->threshold > (ed->depth / 2U)) &&
+			(ed->threshold <= ed->depth));
+
+	if (initial != NULL) {
+		memcpy(ed->level, initial, ed->words * sizeof(*ed->level));
+	} else {
+		memset(ed->level, 0, ed->words * sizeof(*ed->level));
+	}
+
+	for (size_t s = 0U; s < ed->depth; s++) {
+		memcpy(&ed->history[s * ed->words], ed->level,
+		       ed->words * sizeof(*ed->level));
+	}
+
+	ed->head = 0U;
+}
+
+bool edge_detect_update(struct edge_detect *ed,
+			const edge_detect_word_t *sample,
+			edge_detect_word_t *rising, edge_detect_word_t *falling,
+			edge_detect_word_t *changed)
+{
+	edge_detect_word_t any = 0U;
+
+	if (ed->depth > 1U) {
+		/* Overwrite the oldest sample */
+		memcpy(&ed->history[ed->head * ed->words], sample,
+		       ed->words * sizeof(*sample));
+		ed->head = (ed->head + 1U) % ed->depth;
+	}
+
+	for (size_t w = 0U; w < ed->words; w++) {
+		edge_detect_word_t old = ed->level[w];
+		edge_detect_word_t new;
+		edge_detect_word_t diff;
+
+		new = (ed->depth > 1U) ? filter_word(ed, w, old) : sample[w];
+		diff = old ^ new;
+
+		if (rising != NULL) {
+			rising[w] = diff & new;
+		}
+		if (falling != NULL) {
+			falling[w] = diff & old;
+		}
+		if (changed != NULL) {
+			changed[w] = diff;
+		}
+
+		ed->level[w] = new;
+		any |= diff;
+	}
+
+	return any != 0U;
+}
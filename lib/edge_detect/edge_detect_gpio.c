@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/drivers/gpio.h>
+
+#include <app/lib/edge_detect.h>
+
+BUILD_ASSERT((EDGE_DETECT_WORD_BITS % GPIO_MAX_PINS_PER_PORT) == 0U,
+	     "ports must not straddle snapshot words");
+
+#define PORTS_PER_WORD (EDGE_DETECT_WORD_BITS / GPIO_MAX_PINS_PER_PORT)
+
+int edge_detect_sample_ports(const struct device *const *ports,
+			     size_t num_ports, edge_detect_word_t *sample)
+{
+	memset(sample, 0,
+	       EDGE_DETECT_WORDS(num_ports * GPIO_MAX_PINS_PER_PORT) *
+		       sizeof(*sample));
+
+	for (size_t p = 0U; p < num_ports; p++) {
+		gpio_port_value_t value;
+		int ret;
+
+		ret = gpio_port_get_raw(ports[p], &value);
+		if (ret < 0) {
+			return ret;
+		}
+
+		sample[p / PORTS_PER_WORD] |=
+			(edge_detect_word_t)value
+			<< ((p % PORTS_PER_WORD) * GPIO_MAX_PINS_PER_PORT);
+	}
+
+	return 0;
+}
@@ -0,0 +1,758 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+
+#include <app/lib/event_log.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(event_log, CONFIG_EVENT_LOG_LOG_LEVEL);
+
+#define PAGE_SIZE  CONFIG_EVENT_LOG_PAGE_SIZE
+#define FILE_PAGES CONFIG_EVENT_LOG_FILE_PAGES
+#define NUM_FILES  CONFIG_EVENT_LOG_NUM_FILES
+
+#define PAGE_MAGIC   0x454CU
+#define PATH_MAX_LEN 48U
+
+/* Worst case entry: delta and value varints of a 32-bit integer, id varint */
+#define ENTRY_MAX_LEN (5U + 3U + 5U)
+
+/*
+ * Page header, in CPU byte order. Events follow, each made of three
+ * varints: the delta from the previous event uptime (from first_ms for the
+ * first event), (id << 1) | type, and the zigzag-encoded value. Uptimes
+ * restart at each boot, they are only ordered within pages of the same boot.
+ */
+struct page_header {
+	uint16_t magic;
+	/* Number of events */
+	uint16_t count;
+	/* Bytes of encoded events */
+	uint16_t used;
+	/* Boot the events were added in */
+	uint16_t boot;
+	/* Page sequence number, kept across initializations */
+	uint32_t seq;
+	/* Uptime of the first and last events */
+	uint32_t first_ms;
+	uint32_t last_ms;
+};
+
+#define PAGE_DATA_SIZE (PAGE_SIZE - sizeof(struct page_header))
+
+struct page {
+	struct page_header hdr;
+	uint8_t data[PAGE_DATA_SIZE];
+};
+
+BUILD_ASSERT(sizeof(struct page) == PAGE_SIZE,
+	     "CONFIG_EVENT_LOG_PAGE_SIZE must be a multiple of 4");
+
+/* RAM page and its place in the log files */
+struct page_buf {
+	struct page page;
+	uint16_t file;
+	uint16_t slot;
+	/* Full, waiting to be written */
+	bool pending;
+};
+
+struct query {
+	uint16_t boot;
+	uint32_t from_ms;
+	uint32_t to_ms;
+	event_log_cb_t cb;
+	void *user_data;
+	int count;
+	bool stop;
+	bool started;
+	uint32_t last_seq;
+};
+
+static const char *log_dir;
+
+/* RAM pages, page placement and counters */
+static K_MUTEX_DEFINE(lock);
+/* Log files, and the static buffers used while accessing them */
+static K_MUTEX_DEFINE(fs_lock);
+
+static struct page_buf bufs[2];
+/* Page taking new events, NULL while both pages wait to be written */
+static struct page_buf *active;
+static uint32_t last_ms;
+/* Boot of the events added since initialization */
+static uint16_t log_boot;
+
+/* Placement of the next page */
+static uint16_t next_file;
+static uint16_t next_slot;
+static uint32_t next_seq;
+
+static struct event_log_stats stats;
+
+static K_THREAD_STACK_DEFINE(write_stack, CONFIG_EVENT_LOG_STACK_SIZE);
+static struct k_work_q write_q;
+static bool write_q_started;
+
+static void write_work_handler(struct k_work *work);
+static K_WORK_DEFINE(write_work, write_work_handler);
+
+static bool seq_after(uint32_t a, uint32_t b)
+{
+	return (int32_t)(a - b) > 0;
+}
+
+static size_t varint_put(uint8_t *buf, uint32_t val)
+{
+	size_t len = 0U;
+
+	while (val >= 0x80U) {
+		buf[len++] = (uint8_t)val | 0x80U;
+		val >>= 7;
+	}
+	buf[len++] = (uint8_t)val;
+
+	return len;
+}
+
+/* Return the varint length, or 0 if truncated */
+static size_t varint_get(const uint8_t *buf, size_t size, uint32_t *val)
+{
+	uint32_t v = 0U;
+
+	for (size_t i = 0U; (i < size) && (i < 5U); i++) {
+		v |= (uint32_t)(buf[i] & 0x7FU) << (7U * i);
+		if ((buf[i] & 0x80U) == 0U) {
+			*val = v;
+			return i + 1U;
+		}
+	}
+
+	return 0U;
+}
+
+static size_t entry_encode(uint8_t *buf, const struct event_log_event *event,
+			   uint32_t prev_ms)
+{
+	uint32_t value = ((uint32_t)event->value << 1) ^
+			 (uint32_t)(event->value >> 31);
+	size_t len;
+
+	len = varint_put(buf, event->uptime_ms - prev_ms);
+	len += varint_put(&buf[len], ((uint32_t)event->id << 1) | event->type);
+	len += varint_put(&buf[len], value);
+
+	return len;
+}
+
+/* Return the entry length, or 0 if corrupted */
+static size_t entry_decode(const uint8_t *buf, size_t size,
+			   struct event_log_event *event, uint32_t prev_ms)
+{
+	uint32_t vals[3];
+	size_t pos = 0U;
+	size_t len;
+
+	for (size_t i = 0U; i < ARRAY_SIZE(vals); i++) {
+		len = varint_get(&buf[pos], size - pos, &vals[i]);
+		if (len == 0U) {
+			return 0U;
+		}
+		pos += len;
+	}
+
+	event->uptime_ms = prev_ms + vals[0];
+	event->id = (uint16_t)(vals[1] >> 1);
+	event->type = (uint8_t)(vals[1] & 1U);
+	event->value = (int32_t)(vals[2] >> 1) ^ -(int32_t)(vals[2] & 1U);
+
+	return pos;
+}
+
+static bool header_valid(const struct page_header *hdr)
+{
+	return (hdr->magic == PAGE_MAGIC) && (hdr->count > 0U) &&
+	       (hdr->used <= PAGE_DATA_SIZE);
+}
+
+static void page_path(char *path, const char *dir, uint16_t file)
+{
+	(void)snprintf(path, PATH_MAX_LEN, "%s/log%u", dir, file);
+}
+
+static void page_start(struct page_buf *buf, uint32_t uptime_ms)
+{
+	memset(&buf->page, 0, sizeof(buf->page));
+	buf->page.hdr.magic = PAGE_MAGIC;
+	buf->page.hdr.boot = log_boot;
+	buf->page.hdr.seq = next_seq++;
+	buf->page.hdr.first_ms = uptime_ms;
+	buf->page.hdr.last_ms = uptime_ms;
+
+	buf->file = next_file;
+	buf->slot = next_slot;
+
+	if (++next_slot == FILE_PAGES) {
+		next_slot = 0U;
+		next_file = (next_file + 1U) % NUM_FILES;
+	}
+}
+
+static int page_write(const struct page_buf *buf)
+{
+	char path[PATH_MAX_LEN];
+	struct fs_file_t file;
+	ssize_t written;
+	int ret;
+
+	page_path(path, log_dir, buf->file);
+	fs_file_t_init(&file);
+
+	ret = fs_open(&file, path, FS_O_CREATE | FS_O_RDWR);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* The first page of a file drops what the previous rotation left */
+	if (buf->slot == 0U) {
+		ret = fs_truncate(&file, 0);
+	}
+
+	if (ret == 0) {
+		ret = fs_seek(&file, (off_t)buf->slot * PAGE_SIZE, FS_SEEK_SET);
+	}
+
+	if (ret == 0) {
+		written = fs_write(&file, &buf->page, PAGE_SIZE);
+		if (written < 0) {
+			ret = (int)written;
+		} else if (written != PAGE_SIZE) {
+			ret = -ENOSPC;
+		}
+	}
+
+	if (ret == 0) {
+		ret = fs_close(&file);
+	} else {
+		(void)fs_close(&file);
+	}
+
+	if (ret == 0) {
+		k_mutex_lock(&lock, K_FOREVER);
+		stats.pages_written++;
+		stats.bytes_written += PAGE_SIZE;
+		k_mutex_unlock(&lock);
+	}
+
+	return ret;
+}
+
+/* Write the full pages, oldest first. Called with fs_lock held. */
+static int write_pending(void)
+{
+	struct page_buf *buf;
+	int ret = 0;
+	int err;
+
+	while (true) {
+		k_mutex_lock(&lock, K_FOREVER);
+		buf = NULL;
+		for (size_t i = 0U; i < ARRAY_SIZE(bufs); i++) {
+			if (bufs[i].pending &&
+			    ((buf == NULL) ||
+			     seq_after(buf->page.hdr.seq, bufs[i].page.hdr.seq))) {
+				buf = &bufs[i];
+			}
+		}
+		k_mutex_unlock(&lock);
+
+		if (buf == NULL) {
+			return ret;
+		}
+
+		/* Full pages are not modified, no need to hold the lock */
+		err = page_write(buf);
+		if (err < 0) {
+			LOG_ERR("Could not write page %u (%d)", buf->page.hdr.seq,
+				err);
+			ret = err;
+		}
+
+		/* Released even on error, so that logging goes on */
+		k_mutex_lock(&lock, K_FOREVER);
+		if (err < 0) {
+			stats.dropped += buf->page.hdr.count;
+		}
+		buf->page.hdr.count = 0U;
+		buf->pending = false;
+		if (active == NULL) {
+			active = buf;
+		}
+		k_mutex_unlock(&lock);
+	}
+}
+
+static void write_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&fs_lock, K_FOREVER);
+	(void)write_pending();
+	k_mutex_unlock(&fs_lock);
+}
+
+int event_log_add(const struct event_log_event *event)
+{
+	uint8_t entry[ENTRY_MAX_LEN];
+	struct page_header *hdr;
+	struct page_buf *next;
+	size_t len;
+	int ret = 0;
+
+	if (event->type > EVENT_LOG_PERIOD) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (log_dir == NULL) {
+		ret = -EAGAIN;
+		goto out;
+	}
+
+	/* Wrap-safe, 32-bit uptimes wrap after 49.7 days */
+	if ((stats.events > 0U) &&
+	    ((int32_t)(event->uptime_ms - last_ms) < 0)) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	if (active == NULL) {
+		stats.dropped++;
+		ret = -ENOBUFS;
+		goto out;
+	}
+
+	if (active->page.hdr.count == 0U) {
+		page_start(active, event->uptime_ms);
+	}
+
+	len = entry_encode(entry, event, active->page.hdr.last_ms);
+
+	if (active->page.hdr.used + len > PAGE_DATA_SIZE) {
+		/* Hand the full page over to the write thread */
+		active->pending = true;
+		(void)k_work_submit_to_queue(&write_q, &write_work);
+
+		next = (active == &bufs[0]) ? &bufs[1] : &bufs[0];
+		if (next->pending) {
+			active = NULL;
+			stats.dropped++;
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		active = next;
+		page_start(active, event->uptime_ms);
+		len = entry_encode(entry, event, event->uptime_ms);
+	}
+
+	hdr = &active->page.hdr;
+	memcpy(&active->page.data[hdr->used], entry, len);
+	hdr->used += len;
+	hdr->count++;
+	hdr->last_ms = event->uptime_ms;
+	last_ms = event->uptime_ms;
+
+	stats.events++;
+	stats.encoded_bytes += len;
+
+out:
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+int event_log_sync(void)
+{
+	/* Copy of the partial page, so that events can be added meanwhile */
+	static struct page_buf snapshot;
+	bool partial;
+	int ret;
+
+	if (log_dir == NULL) {
+		return -EAGAIN;
+	}
+
+	k_mutex_lock(&fs_lock, K_FOREVER);
+
+	ret = write_pending();
+	if (ret == 0) {
+		k_mutex_lock(&lock, K_FOREVER);
+		partial = (active != NULL) && (active->page.hdr.count > 0U);
+		if (partial) {
+			snapshot = *active;
+		}
+		k_mutex_unlock(&lock);
+
+		if (partial) {
+			ret = page_write(&snapshot);
+		}
+	}
+
+	k_mutex_unlock(&fs_lock);
+
+	return ret;
+}
+
+/* Check whether a page is to be decoded, tracking the sequence numbers */
+static bool page_wanted(const struct page_header *hdr, struct query *q)
+{
+	/* Pages older than the previous one are left over by a rotation */
+	if (q->started && !seq_after(hdr->seq, q->last_seq)) {
+		return false;
+	}
+
+	q->started = true;
+	q->last_seq = hdr->seq;
+
+	if (hdr->boot != q->boot) {
+		return false;
+	}
+
+	/* Uptime wrapped within the page, its events span the whole range */
+	if (hdr->first_ms > hdr->last_ms) {
+		return true;
+	}
+
+	return (hdr->last_ms >= q->from_ms) && (hdr->first_ms <= q->to_ms);
+}
+
+static void page_decode(const struct page *page, struct query *q)
+{
+	const struct page_header *hdr = &page->hdr;
+	struct event_log_event event;
+	uint32_t prev_ms = hdr->first_ms;
+	size_t pos = 0U;
+	size_t len;
+
+	for (uint16_t i = 0U; (i < hdr->count) && !q->stop; i++) {
+		len = entry_decode(&page->data[pos], hdr->used - pos, &event,
+				   prev_ms);
+		if (len == 0U) {
+			LOG_WRN("Page %u corrupted", hdr->seq);
+			return;
+		}
+
+		pos += len;
+		prev_ms = event.uptime_ms;
+
+		/* Later events of the same boot may be in range again once
+		 * the uptime wrapped, so an event past the end does not stop
+		 * the query
+		 */
+		if ((event.uptime_ms < q->from_ms) ||
+		    (event.uptime_ms > q->to_ms)) {
+			continue;
+		}
+
+		q->count++;
+		q->stop = !q->cb(&event, q->user_data);
+	}
+}
+
+static bool slot_in_ram(const struct page_buf *ram, size_t num_ram,
+			uint16_t file, uint16_t slot)
+{
+	for (size_t i = 0U; i < num_ram; i++) {
+		if ((ram[i].file == file) && (ram[i].slot == slot)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Read the next page header of a file, return 0 if valid */
+static int header_read(struct fs_file_t *file, struct page_header *hdr)
+{
+	ssize_t len;
+
+	len = fs_read(file, hdr, sizeof(*hdr));
+	if (len < 0) {
+		return (int)len;
+	}
+
+	if ((len != sizeof(*hdr)) || !header_valid(hdr)) {
+		return -ENODATA;
+	}
+
+	return 0;
+}
+
+static int file_open(struct fs_file_t *file, uint16_t idx)
+{
+	char path[PATH_MAX_LEN];
+
+	page_path(path, log_dir, idx);
+	fs_file_t_init(file);
+
+	return fs_open(file, path, FS_O_READ);
+}
+
+static int file_query(uint16_t idx, const struct page_buf *ram,
+		      size_t num_ram, struct query *q)
+{
+	static struct page page;
+	struct fs_file_t file;
+	ssize_t len;
+	int ret;
+
+	ret = file_open(&file, idx);
+	if (ret < 0) {
+		return (ret == -ENOENT) ? 0 : ret;
+	}
+
+	for (uint16_t slot = 0U; (slot < FILE_PAGES) && !q->stop; slot++) {
+		ret = header_read(&file, &page.hdr);
+		if (ret < 0) {
+			ret = (ret == -ENODATA) ? 0 : ret;
+			break;
+		}
+
+		/* Pages also in RAM may be older on flash */
+		if (slot_in_ram(ram, num_ram, idx, slot) ||
+		    !page_wanted(&page.hdr, q)) {
+			ret = fs_seek(&file, PAGE_DATA_SIZE, FS_SEEK_CUR);
+			if (ret < 0) {
+				break;
+			}
+			continue;
+		}
+
+		len = fs_read(&file, page.data, PAGE_DATA_SIZE);
+		if (len != PAGE_DATA_SIZE) {
+			ret = (len < 0) ? (int)len : 0;
+			break;
+		}
+
+		page_decode(&page, q);
+	}
+
+	(void)fs_close(&file);
+
+	return ret;
+}
+
+/* Return the sequence number of the first page of a file */
+static int file_first_seq(uint16_t idx, uint32_t *seq)
+{
+	struct page_header hdr;
+	struct fs_file_t file;
+	int ret;
+
+	ret = file_open(&file, idx);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = header_read(&file, &hdr);
+	(void)fs_close(&file);
+
+	if (ret == 0) {
+		*seq = hdr.seq;
+	}
+
+	return ret;
+}
+
+int event_log_query(uint16_t boot, uint32_t from_ms, uint32_t to_ms,
+		    event_log_cb_t cb, void *user_data)
+{
+	static struct page_buf ram[ARRAY_SIZE(bufs)];
+	struct query q = {
+		.boot = boot,
+		.from_ms = from_ms,
+		.to_ms = to_ms,
+		.cb = cb,
+		.user_data = user_data,
+	};
+	uint32_t seqs[NUM_FILES];
+	uint16_t files[NUM_FILES];
+	size_t num_files = 0U;
+	size_t num_ram = 0U;
+	uint32_t seq;
+	int ret = 0;
+
+	if (log_dir == NULL) {
+		return -EAGAIN;
+	}
+
+	/* Also keeps full pages from being written meanwhile */
+	k_mutex_lock(&fs_lock, K_FOREVER);
+
+	k_mutex_lock(&lock, K_FOREVER);
+	for (size_t i = 0U; i < ARRAY_SIZE(bufs); i++) {
+		if (bufs[i].page.hdr.count > 0U) {
+			ram[num_ram++] = bufs[i];
+		}
+	}
+	k_mutex_unlock(&lock);
+
+	if ((num_ram == 2U) &&
+	    seq_after(ram[0].page.hdr.seq, ram[1].page.hdr.seq)) {
+		struct page_buf tmp = ram[0];
+
+		ram[0] = ram[1];
+		ram[1] = tmp;
+	}
+
+	/* Files in the order of their first page */
+	for (uint16_t idx = 0U; idx < NUM_FILES; idx++) {
+		size_t pos;
+
+		if (file_first_seq(idx, &seq) < 0) {
+			continue;
+		}
+
+		for (pos = num_files; (pos > 0U) && seq_after(seqs[pos - 1U], seq);
+		     pos--) {
+			seqs[pos] = seqs[pos - 1U];
+			files[pos] = files[pos - 1U];
+		}
+		seqs[pos] = seq;
+		files[pos] = idx;
+		num_files++;
+	}
+
+	for (size_t i = 0U; (i < num_files) && !q.stop && (ret == 0); i++) {
+		ret = file_query(files[i], ram, num_ram, &q);
+	}
+
+	for (size_t i = 0U; (i < num_ram) && !q.stop && (ret == 0); i++) {
+		if (page_wanted(&ram[i].page.hdr, &q)) {
+			page_decode(&ram[i].page, &q);
+		}
+	}
+
+	k_mutex_unlock(&fs_lock);
+
+	return (ret < 0) ? ret : q.count;
+}
+
+/* Find the most recent page, to resume after it in a new boot */
+static void log_scan(void)
+{
+	struct page_header hdr;
+	struct fs_file_t file;
+	bool found = false;
+	uint16_t last_file = 0U;
+	uint16_t last_slot = 0U;
+	uint16_t last_boot = 0U;
+	uint32_t last_seq = 0U;
+
+	for (uint16_t idx = 0U; idx < NUM_FILES; idx++) {
+		if (file_open(&file, idx) < 0) {
+			continue;
+		}
+
+		for (uint16_t slot = 0U; slot < FILE_PAGES; slot++) {
+			if (header_read(&file, &hdr) < 0) {
+				break;
+			}
+
+			if (!found || seq_after(hdr.seq, last_seq)) {
+				found = true;
+				last_seq = hdr.seq;
+				last_boot = hdr.boot;
+				last_file = idx;
+				last_slot = slot;
+			}
+
+			if (fs_seek(&file, PAGE_DATA_SIZE, FS_SEEK_CUR) < 0) {
+				break;
+			}
+		}
+
+		(void)fs_close(&file);
+	}
+
+	if (!found) {
+		next_file = 0U;
+		next_slot = 0U;
+		next_seq = 0U;
+		log_boot = 0U;
+		return;
+	}
+
+	LOG_INF("Resuming after page %u (file %u, slot %u, boot %u)", last_seq,
+		last_file, last_slot, last_boot);
+
+	log_boot = last_boot + 1U;
+	next_seq = last_seq + 1U;
+	next_file = last_file;
+	next_slot = last_slot + 1U;
+	if (next_slot == FILE_PAGES) {
+		next_slot = 0U;
+		next_file = (last_file + 1U) % NUM_FILES;
+	}
+}
+
+int event_log_init(const char *dir)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "event_log",
+	};
+
+	if (strlen(dir) + sizeof("/log99") > PATH_MAX_LEN) {
+		return -ENAMETOOLONG;
+	}
+
+	k_mutex_lock(&fs_lock, K_FOREVER);
+	k_mutex_lock(&lock, K_FOREVER);
+
+	log_dir = dir;
+	log_scan();
+
+	memset(bufs, 0, sizeof(bufs));
+	active = &bufs[0];
+	last_ms = 0U;
+	memset(&stats, 0, sizeof(stats));
+
+	if (!write_q_started) {
+		k_work_queue_start(&write_q, write_stack,
+				   K_THREAD_STACK_SIZEOF(write_stack),
+				   CONFIG_EVENT_LOG_THREAD_PRIORITY, &cfg);
+		write_q_started = true;
+	}
+
+	k_mutex_unlock(&lock);
+	k_mutex_unlock(&fs_lock);
+
+	return 0;
+}
+
+uint16_t event_log_boot(void)
+{
+	uint16_t ret;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	ret = log_boot;
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+void event_log_stats_get(struct event_log_stats *out)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	*out = stats;
+	k_mutex_unlock(&lock);
+}
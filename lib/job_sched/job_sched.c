@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/dlist.h>
+
+#include <app/lib/job_sched.h>
+
+/* Scheduled jobs, sorted by deadline */
+static sys_dlist_t jobs = SYS_DLIST_STATIC_INIT(&jobs);
+static struct k_spinlock lock;
+static K_SEM_DEFINE(wake_sem, 0, 1);
+static atomic_t stop_requested;
+/* Protected by lock */
+static struct job_sched_stats stats;
+
+static void insert_locked(struct job_sched_job *job)
+{
+	struct job_sched_job *it;
+
+	job->deadline = job->due + k_ms_to_ticks_ceil64(job->slack_ms);
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&jobs, it, node) {
+		if (job->deadline < it->deadline) {
+			sys_dlist_insert(&it->node, &job->node);
+			return;
+		}
+	}
+
+	sys_dlist_append(&jobs, &job->node);
+}
+
+void job_sched_job_init(struct job_sched_job *job, job_sched_handler_t handler,
+			uint32_t period_ms, uint32_t slack_ms)
+{
+	*job = (struct job_sched_job)JOB_SCHED_JOB_INITIALIZER(handler, period_ms,
+								slack_ms);
+	sys_dnode_init(&job->node);
+}
+
+int job_sched_add(struct job_sched_job *job, uint32_t delay_ms)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lock);
+
+	if (sys_dnode_is_linked(&job->node)) {
+		k_spin_unlock(&lock, key);
+		return -EALREADY;
+	}
+
+	job->due = k_uptime_ticks() + k_ms_to_ticks_ceil64(delay_ms);
+	insert_locked(job);
+
+	k_spin_unlock(&lock, key);
+
+	/* The new job may be due before the current wakeup */
+	k_sem_give(&wake_sem);
+
+	return 0;
+}
+
+int job_sched_remove(struct job_sched_job *job)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lock);
+
+	if (!sys_dnode_is_linked(&job->node)) {
+		k_spin_unlock(&lock, key);
+		return -EALREADY;
+	}
+
+	sys_dlist_remove(&job->node);
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+/* Take the earliest deadline job that is due, and schedule its next run */
+static struct job_sched_job *next_due_locked(int64_t now)
+{
+	struct job_sched_job *job;
+	int64_t period;
+	int64_t skipped;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&jobs, job, node) {
+		if (job->due <= now) {
+			break;
+		}
+	}
+
+	if (job == NULL) {
+		return NULL;
+	}
+
+	sys_dlist_remove(&job->node);
+
+	if (job->period_ms == 0U) {
+		return job;
+	}
+
+	period = k_ms_to_ticks_ceil64(job->period_ms);
+	job->due += period;
+
+	/* Keep the phase, skipping the periods that were missed */
+	if (job->due <= now) {
+		skipped = (now - job->due) / period + 1;
+		job->due += skipped * period;
+		job->overruns += (uint32_t)skipped;
+	}
+
+	insert_locked(job);
+
+	return job;
+}
+
+static void run_due(void)
+{
+	int64_t now = k_uptime_ticks();
+	struct job_sched_job *job;
+	k_spinlock_key_t key;
+
+	while (true) {
+		key = k_spin_lock(&lock);
+		job = next_due_locked(now);
+		if (job != NULL) {
+			job->runs++;
+			stats.runs++;
+		}
+		k_spin_unlock(&lock, key);
+
+		if (job == NULL) {
+			return;
+		}
+
+		/* Periodic jobs are already rescheduled, so handlers may
+		 * remove them, and one-shot jobs may add themselves again.
+		 */
+		job->handler(job);
+	}
+}
+
+void job_sched_run(void)
+{
+	struct job_sched_job *first;
+	k_spinlock_key_t key;
+	k_timeout_t timeout;
+	int ret;
+
+	while (!atomic_cas(&stop_requested, 1, 0)) {
+		key = k_spin_lock(&lock);
+		first = SYS_DLIST_PEEK_HEAD_CONTAINER(&jobs, first, node);
+		timeout = (first != NULL) ? K_TIMEOUT_ABS_TICKS(first->deadline)
+					  : K_FOREVER;
+		k_spin_unlock(&lock, key);
+
+		/* Sleep until the earliest deadline, all due jobs then run */
+		ret = k_sem_take(&wake_sem, timeout);
+
+		/* Not counted when woken early by job_sched_add() or
+		 * job_sched_stop()
+		 */
+		if (ret == -EAGAIN) {
+			key = k_spin_lock(&lock);
+			stats.wakeups++;
+			k_spin_unlock(&lock, key);
+		}
+
+		run_due();
+	}
+}
+
+void job_sched_stop(void)
+{
+	atomic_set(&stop_requested, 1);
+	k_sem_give(&wake_sem);
+}
+
+void job_sched_stats_get(struct job_sched_stats *out)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lock);
+	*out = stats;
+	k_spin_unlock(&lock, key);
+}
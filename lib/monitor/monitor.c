@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include <app/lib/monitor.h>
+
+struct monitor_thread_cycles {
+	const struct k_thread *thread;
+	uint64_t cycles;
+};
+
+struct monitor_sample {
+	struct monitor_thread_cycles *prev;
+	size_t prev_count;
+	struct monitor_thread_cycles *next;
+	size_t next_count;
+	struct monitor_record_thread *entries;
+	uint64_t window;
+};
+
+static struct monitor_thread_cycles cycles[2][CONFIG_MONITOR_MAX_THREADS];
+static size_t cycles_count;
+static uint8_t cycles_idx;
+
+static uint8_t record[sizeof(struct monitor_record_header) +
+		      CONFIG_MONITOR_MAX_THREADS *
+			      sizeof(struct monitor_record_thread)];
+
+static uint64_t prev_total;
+static uint64_t prev_idle;
+
+static monitor_report_cb_t report_cb;
+static void *report_user_data;
+
+static void monitor_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(monitor_work, monitor_work_handler);
+
+static uint16_t permille(uint64_t part, uint64_t whole)
+{
+	if (whole == 0U) {
+		return 0U;
+	}
+
+	return (uint16_t)MIN((part * 1000U) / whole, 1000U);
+}
+
+static uint64_t prev_cycles(const struct monitor_sample *sample,
+			    const struct k_thread *thread)
+{
+	for (size_t i = 0; i < sample->prev_count; i++) {
+		if (sample->prev[i].thread == thread) {
+			return sample->prev[i].cycles;
+		}
+	}
+
+	/* Thread created during the last period */
+	return 0U;
+}
+
+static void monitor_sample_thread(const struct k_thread *cthread,
+				  void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	struct monitor_sample *sample = user_data;
+	struct monitor_record_thread *entry;
+	k_thread_runtime_stats_t stats;
+	const char *name;
+	size_t unused = 0U;
+	size_t i = sample->next_count;
+
+	if (i >= CONFIG_MONITOR_MAX_THREADS) {
+		return;
+	}
+
+	if (k_thread_runtime_stats_get(thread, &stats) < 0) {
+		return;
+	}
+
+	sample->next[i].thread = thread;
+	sample->next[i].cycles = stats.execution_cycles;
+	sample->next_count++;
+
+	/* Priming pass, only record the current cycle counts */
+	if (sample->entries == NULL) {
+		return;
+	}
+
+	(void)k_thread_stack_space_get(thread, &unused);
+
+	entry = &sample->entries[i];
+	memset(entry->name, 0, sizeof(entry->name));
+	name = k_thread_name_get(thread);
+	if (name != NULL) {
+		/* Truncated, the last byte is left as the terminator */
+		memcpy(entry->name, name,
+		       strnlen(name, sizeof(entry->name) - 1U));
+	}
+
+	entry->cpu_permille = sys_cpu_to_le16(
+		permille(stats.execution_cycles - prev_cycles(sample, thread),
+			 sample->window));
+	entry->stack_size = sys_cpu_to_le16(
+		(uint16_t)MIN(thread->stack_info.size, UINT16_MAX));
+	entry->stack_used = sys_cpu_to_le16((uint16_t)MIN(
+		thread->stack_info.size - unused, UINT16_MAX));
+}
+
+static void monitor_work_handler(struct k_work *work)
+{
+	struct monitor_record_header *hdr = (struct monitor_record_header *)record;
+	struct monitor_sample sample;
+	k_thread_runtime_stats_t all;
+
+	ARG_UNUSED(work);
+
+	(void)k_work_schedule(&monitor_work, K_MSEC(CONFIG_MONITOR_PERIOD_MS));
+
+	if (k_thread_runtime_stats_all_get(&all) < 0) {
+		return;
+	}
+
+	sample.prev = cycles[cycles_idx];
+	sample.prev_count = cycles_count;
+	sample.next = cycles[cycles_idx ^ 1U];
+	sample.next_count = 0U;
+	sample.entries = (struct monitor_record_thread *)(hdr + 1);
+	sample.window = all.execution_cycles - prev_total;
+
+	k_thread_foreach_unlocked(monitor_sample_thread, &sample);
+
+	hdr->uptime_ms = sys_cpu_to_le32(k_uptime_get_32());
+	hdr->idle_permille = sys_cpu_to_le16(
+		permille(all.idle_cycles - prev_idle, sample.window));
+	hdr->num_threads = (uint8_t)sample.next_count;
+	hdr->reserved = 0U;
+
+	prev_total = all.execution_cycles;
+	prev_idle = all.idle_cycles;
+	cycles_idx ^= 1U;
+	cycles_count = sample.next_count;
+
+	report_cb(record,
+		  sizeof(*hdr) + sample.next_count * sizeof(*sample.entries),
+		  report_user_data);
+}
+
+int monitor_start(monitor_report_cb_t cb, void *user_data)
+{
+	struct monitor_sample sample = { 0 };
+	k_thread_runtime_stats_t all;
+
+	if (report_cb != NULL) {
+		return -EALREADY;
+	}
+
+	(void)k_thread_runtime_stats_all_get(&all);
+	prev_total = all.execution_cycles;
+	prev_idle = all.idle_cycles;
+
+	/* Take a first sample so that reports cover one period only */
+	sample.next = cycles[cycles_idx];
+	k_thread_foreach_unlocked(monitor_sample_thread, &sample);
+	cycles_count = sample.next_count;
+
+	report_cb = cb;
+	report_user_data = user_data;
+
+	(void)k_work_schedule(&monitor_work, K_MSEC(CONFIG_MONITOR_PERIOD_MS));
+
+	return 0;
+}
+
+void monitor_stop(void)
+{
+	struct k_work_sync sync;
+
+	(void)k_work_cancel_delayable_sync(&monitor_work, &sync);
+
+	report_cb = NULL;
+}
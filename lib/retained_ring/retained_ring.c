@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/linker/section_tags.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/crc.h>
+
+#include <app/lib/retained_ring.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(retained_ring, CONFIG_RETAINED_RING_LOG_LEVEL);
+
+#define RING_LEN   CONFIG_RETAINED_RING_LEN
+#define RING_MAGIC 0x52524E47U
+#define CRC8_SEED  0xFFU
+
+BUILD_ASSERT(sizeof(struct retained_ring_entry) == 16U);
+
+struct retained_ring {
+	uint32_t magic;
+	/* Rejects a ring left by a build with another length */
+	uint32_t len;
+	uint32_t boots;
+	/* CRC-32 of the fields above */
+	uint32_t crc;
+	struct retained_ring_entry entries[RING_LEN];
+};
+
+/* Not cleared at boot, validated by retained_ring_init() */
+static struct retained_ring ring __noinit;
+
+static struct k_spinlock lock;
+static bool ready;
+/* Next entry to write, the oldest one once the ring is full */
+static size_t head;
+static uint32_t next_seq;
+/* First sequence number of the current boot */
+static uint32_t boot_seq;
+
+static bool seq_after(uint32_t a, uint32_t b)
+{
+	return (int32_t)(a - b) > 0;
+}
+
+static uint32_t header_crc(void)
+{
+	return crc32_ieee((const uint8_t *)&ring,
+			  offsetof(struct retained_ring, crc));
+}
+
+static uint8_t entry_crc(const struct retained_ring_entry *entry)
+{
+	return crc8_ccitt(CRC8_SEED, entry,
+			  offsetof(struct retained_ring_entry, crc));
+}
+
+static bool entry_valid(const struct retained_ring_entry *entry)
+{
+	return (entry->type <= RETAINED_RING_LATENCY) &&
+	       (entry->crc == entry_crc(entry));
+}
+
+static void ring_reset(void)
+{
+	memset(&ring, 0, sizeof(ring));
+	ring.magic = RING_MAGIC;
+	ring.len = RING_LEN;
+	ring.crc = header_crc();
+
+	head = 0U;
+	next_seq = 0U;
+	boot_seq = 0U;
+}
+
+int retained_ring_init(void)
+{
+	const struct retained_ring_entry *entry;
+	k_spinlock_key_t key;
+	uint32_t last_seq = 0U;
+	bool found = false;
+	int kept;
+
+	key = k_spin_lock(&lock);
+
+	if ((ring.magic != RING_MAGIC) || (ring.len != RING_LEN) ||
+	    (ring.crc != header_crc())) {
+		ring_reset();
+	} else {
+		/* Resume after the most recent valid entry */
+		for (size_t i = 0U; i < RING_LEN; i++) {
+			entry = &ring.entries[i];
+			if (entry_valid(entry) &&
+			    (!found || seq_after(entry->seq, last_seq))) {
+				found = true;
+				last_seq = entry->seq;
+				head = (i + 1U) % RING_LEN;
+			}
+		}
+
+		next_seq = found ? (last_seq + 1U) : 0U;
+		boot_seq = next_seq;
+
+		ring.boots++;
+		ring.crc = header_crc();
+	}
+
+	ready = true;
+
+	k_spin_unlock(&lock, key);
+
+	kept = retained_ring_foreach_previous(NULL, NULL);
+
+	LOG_INF("Boot %u, %d entries kept", ring.boots, kept);
+
+	return kept;
+}
+
+void retained_ring_record(enum retained_ring_type type, uint16_t id,
+			  int32_t value)
+{
+	struct retained_ring_entry *entry;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lock);
+
+	if (!ready) {
+		k_spin_unlock(&lock, key);
+		return;
+	}
+
+	entry = &ring.entries[head];
+	entry->seq = next_seq++;
+	entry->uptime_ms = k_uptime_get_32();
+	entry->value = value;
+	entry->id = id;
+	entry->type = (uint8_t)type;
+	/* Written last, a reset before this leaves the entry invalid */
+	entry->crc = entry_crc(entry);
+
+	head = (head + 1U) % RING_LEN;
+
+	k_spin_unlock(&lock, key);
+}
+
+int retained_ring_foreach_previous(retained_ring_cb_t cb, void *user_data)
+{
+	struct retained_ring_entry entry;
+	k_spinlock_key_t key;
+	uint32_t last_seq = 0U;
+	bool found = false;
+	int count = 0;
+
+	for (size_t i = 0U; i < RING_LEN; i++) {
+		/* Copied, the callback runs without holding the lock */
+		key = k_spin_lock(&lock);
+		entry = ring.entries[(head + i) % RING_LEN];
+		k_spin_unlock(&lock, key);
+
+		if (!entry_valid(&entry) || !seq_after(boot_seq, entry.seq) ||
+		    (found && !seq_after(entry.seq, last_seq))) {
+			continue;
+		}
+
+		found = true;
+		last_seq = entry.seq;
+		count++;
+
+		if (cb != NULL) {
+			cb(&entry, user_data);
+		}
+	}
+
+	return count;
+}
+
+uint32_t retained_ring_boots(void)
+{
+	return ring.boots;
+}
+
+void retained_ring_clear(void)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lock);
+	ring_reset();
+	k_spin_unlock(&lock, key);
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdint.h>
+
+#include <zephyr/shell/shell.h>
+#include <zephyr/stats/stats.h>
+
+static int stat_list_cb(struct stats_hdr *hdr, void *arg)
+{
+	const struct shell *sh = arg;
+
+	shell_print(sh, "%s", hdr->s_name);
+
+	return 0;
+}
+
+static int stat_show_cb(struct stats_hdr *hdr, void *arg, const char *name,
+			uint16_t off)
+{
+	const struct shell *sh = arg;
+	const uint8_t *ptr = (const uint8_t *)hdr + off;
+	uint64_t val;
+
+	switch (hdr->s_size) {
+	case sizeof(uint16_t):
+		val = *(const uint16_t *)ptr;
+		break;
+	case sizeof(uint32_t):
+		val = *(const uint32_t *)ptr;
+		break;
+	case sizeof(uint64_t):
+		val = *(const uint64_t *)ptr;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	shell_print(sh, "%s: %llu", name, (unsigned long long)val);
+
+	return 0;
+}
+
+static int cmd_stat_list(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	return stats_group_walk(stat_list_cb, (void *)sh);
+}
+
+static int cmd_stat_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct stats_hdr *hdr;
+
+	ARG_UNUSED(argc);
+
+	hdr = stats_group_find(argv[1]);
+	if (hdr == NULL) {
+		shell_error(sh, "Unknown group %s", argv[1]);
+		return -ENOENT;
+	}
+
+	return stats_walk(hdr, stat_show_cb, (void *)sh);
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_stat,
+	SHELL_CMD_ARG(list, NULL, "List the groups", cmd_stat_list, 1, 0),
+	SHELL_CMD_ARG(show, NULL, "Print the counters of a group: <group>",
+		      cmd_stat_show, 2, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(stat, &sub_stat, "Statistics groups", NULL);
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zcbor_encode.h>
+
+#include <app/lib/telemetry.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(telemetry, CONFIG_TELEMETRY_LOG_LEVEL);
+
+#if DT_HAS_CHOSEN(app_telemetry_uart)
+#define TELEMETRY_UART_NODE DT_CHOSEN(app_telemetry_uart)
+#else
+#define TELEMETRY_UART_NODE DT_CHOSEN(zephyr_console)
+#endif
+
+#define QUEUE_LEN  CONFIG_TELEMETRY_QUEUE_LEN
+#define BATCH_SIZE CONFIG_TELEMETRY_BATCH_SIZE
+#define MAX_VALUES CONFIG_TELEMETRY_MAX_VALUES
+#define BUF_SIZE   CONFIG_TELEMETRY_BUF_SIZE
+
+/* Magic and 16-bit payload length */
+#define FRAME_HEADER_LEN 3U
+
+/* Worst case CBOR sizes: list header, 32-bit integers in 5 bytes */
+#define BATCH_HEADER_MAX_LEN (2U + 3U * 5U + 2U + 1U)
+#define RECORD_MAX_LEN       (2U + 5U + 5U + 3U + MAX_VALUES * 5U + 1U)
+
+BUILD_ASSERT(BUF_SIZE >= FRAME_HEADER_LEN + BATCH_HEADER_MAX_LEN +
+			 BATCH_SIZE * RECORD_MAX_LEN,
+	     "CONFIG_TELEMETRY_BUF_SIZE too small for a full batch");
+BUILD_ASSERT(BATCH_SIZE <= QUEUE_LEN);
+
+struct telemetry_record {
+	uint32_t uptime_ms;
+	uint8_t type;
+	uint8_t count;
+	uint16_t id;
+	int32_t values[MAX_VALUES];
+};
+
+static const struct device *const uart = DEVICE_DT_GET(TELEMETRY_UART_NODE);
+
+static struct k_spinlock lock;
+
+/* Record queue, filled by producers and drained by the flush work */
+static struct telemetry_record queue[QUEUE_LEN];
+static size_t queue_head;
+static size_t queue_count;
+static uint32_t dropped;
+
+/* One buffer is sent while the other one is encoded */
+static uint8_t bufs[2][BUF_SIZE];
+static size_t buf_len[2];
+/* Records lost if a buffer can not be sent: its own and the ones it reports
+ * as dropped
+ */
+static uint32_t buf_lost[2];
+static int tx_buf = -1;
+static uint32_t seq;
+
+static void flush_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(flush_work, flush_work_handler);
+
+static int record_put(uint8_t type, uint16_t id, const int32_t *values,
+		      size_t count)
+{
+	struct telemetry_record *rec;
+	k_spinlock_key_t key;
+	size_t pending;
+
+	key = k_spin_lock(&lock);
+
+	if (queue_count == QUEUE_LEN) {
+		dropped++;
+		k_spin_unlock(&lock, key);
+		return -ENOBUFS;
+	}
+
+	rec = &queue[(queue_head + queue_count) % QUEUE_LEN];
+	rec->uptime_ms = k_uptime_get_32();
+	rec->type = type;
+	rec->id = id;
+	rec->count = (uint8_t)count;
+	for (size_t i = 0U; i < count; i++) {
+		rec->values[i] = values[i];
+	}
+
+	pending = ++queue_count;
+
+	k_spin_unlock(&lock, key);
+
+	if (pending >= BATCH_SIZE) {
+		(void)k_work_reschedule(&flush_work, K_NO_WAIT);
+	} else {
+		/* Keeps the deadline of the first record of the batch */
+		(void)k_work_schedule(&flush_work,
+				      K_MSEC(CONFIG_TELEMETRY_FLUSH_MS));
+	}
+
+	return 0;
+}
+
+int telemetry_edge(uint16_t pair, bool near)
+{
+	int32_t value = near ? 1 : 0;
+
+	return record_put(TELEMETRY_TYPE_EDGE, pair, &value, 1U);
+}
+
+int telemetry_period(uint16_t pair, uint32_t period_ms)
+{
+	int32_t value = (int32_t)period_ms;
+
+	return record_put(TELEMETRY_TYPE_PERIOD, pair, &value, 1U);
+}
+
+int telemetry_stats(uint16_t source, const int32_t *values, size_t count)
+{
+	if (count > MAX_VALUES) {
+		return -EINVAL;
+	}
+
+	return record_put(TELEMETRY_TYPE_STATS, source, values, count);
+}
+
+void telemetry_flush(void)
+{
+	(void)k_work_reschedule(&flush_work, K_NO_WAIT);
+}
+
+static bool record_encode(zcbor_state_t *state,
+			  const struct telemetry_record *rec, uint32_t base_ms)
+{
+	bool ok;
+
+	ok = zcbor_list_start_encode(state, 3U + rec->count) &&
+	     zcbor_uint32_put(state, rec->type) &&
+	     zcbor_uint32_put(state, rec->uptime_ms - base_ms) &&
+	     zcbor_uint32_put(state, rec->id);
+
+	for (size_t i = 0U; ok && (i < rec->count); i++) {
+		ok = zcbor_int32_put(state, rec->values[i]);
+	}
+
+	return ok && zcbor_list_end_encode(state, 3U + rec->count);
+}
+
+/* Encode a batch into a frame, return the frame length or 0 on error */
+static size_t batch_encode(uint8_t *buf, const struct telemetry_record *recs,
+			   size_t count, uint32_t batch_seq,
+			   uint32_t batch_dropped)
+{
+	uint8_t *payload = buf + FRAME_HEADER_LEN;
+	uint32_t base_ms = recs[0].uptime_ms;
+	size_t len;
+	bool ok;
+
+	ZCBOR_STATE_E(state, 2, payload, BUF_SIZE - FRAME_HEADER_LEN, 1);
+
+	ok = zcbor_list_start_encode(state, 4) &&
+	     zcbor_uint32_put(state, batch_seq) &&
+	     zcbor_uint32_put(state, base_ms) &&
+	     zcbor_uint32_put(state, batch_dropped) &&
+	     zcbor_list_start_encode(state, count);
+
+	for (size_t i = 0U; ok && (i < count); i++) {
+		ok = record_encode(state, &recs[i], base_ms);
+	}
+
+	ok = ok && zcbor_list_end_encode(state, count) &&
+	     zcbor_list_end_encode(state, 4);
+	if (!ok) {
+		LOG_ERR("Encoding failed (%d)", zcbor_peek_error(state));
+		return 0U;
+	}
+
+	len = state->payload - payload;
+
+	buf[0] = TELEMETRY_FRAME_MAGIC;
+	sys_put_le16((uint16_t)len, &buf[1]);
+
+	return FRAME_HEADER_LEN + len;
+}
+
+/* Start sending buffer idx, batches the UART refuses are dropped */
+static void tx_start(int idx)
+{
+	k_spinlock_key_t key;
+	int ret;
+
+	while (idx >= 0) {
+		ret = uart_tx(uart, bufs[idx], buf_len[idx], SYS_FOREVER_US);
+		if (ret == 0) {
+			return;
+		}
+
+		LOG_ERR("Could not send batch (%d)", ret);
+
+		/* No TX_DONE event will free the buffer */
+		key = k_spin_lock(&lock);
+
+		dropped += buf_lost[idx];
+		buf_len[idx] = 0U;
+		buf_lost[idx] = 0U;
+
+		idx = (idx == 0) ? 1 : 0;
+		if (buf_len[idx] != 0U) {
+			tx_buf = idx;
+		} else {
+			tx_buf = -1;
+			idx = -1;
+		}
+
+		k_spin_unlock(&lock, key);
+	}
+
+	/* Retried with the next flush, not right away */
+	(void)k_work_schedule(&flush_work, K_MSEC(CONFIG_TELEMETRY_FLUSH_MS));
+}
+
+static void flush_work_handler(struct k_work *work)
+{
+	struct telemetry_record recs[BATCH_SIZE];
+	uint32_t batch_dropped;
+	uint32_t batch_seq;
+	k_spinlock_key_t key;
+	size_t pending;
+	size_t count;
+	size_t len;
+	bool start;
+	int idx;
+
+	ARG_UNUSED(work);
+
+	key = k_spin_lock(&lock);
+
+	/* Both buffers busy: the end of transmission flushes again */
+	idx = (tx_buf == 0) ? 1 : 0;
+	if ((buf_len[idx] != 0U) || (queue_count == 0U)) {
+		k_spin_unlock(&lock, key);
+		return;
+	}
+
+	count = MIN(queue_count, BATCH_SIZE);
+	for (size_t i = 0U; i < count; i++) {
+		recs[i] = queue[(queue_head + i) % QUEUE_LEN];
+	}
+	queue_head = (queue_head + count) % QUEUE_LEN;
+	queue_count -= count;
+
+	batch_dropped = dropped;
+	dropped = 0U;
+	batch_seq = seq++;
+
+	k_spin_unlock(&lock, key);
+
+	/* Out of the lock, producers are never held up by encoding */
+	len = batch_encode(bufs[idx], recs, count, batch_seq, batch_dropped);
+
+	key = k_spin_lock(&lock);
+
+	if (len == 0U) {
+		/* Reported with the next batch */
+		dropped += batch_dropped + count;
+		k_spin_unlock(&lock, key);
+		return;
+	}
+
+	buf_len[idx] = len;
+	buf_lost[idx] = batch_dropped + count;
+	start = (tx_buf < 0);
+	if (start) {
+		tx_buf = idx;
+	}
+	pending = queue_count;
+
+	k_spin_unlock(&lock, key);
+
+	if (start) {
+		tx_start(idx);
+	}
+
+	if (pending >= BATCH_SIZE) {
+		(void)k_work_reschedule(&flush_work, K_NO_WAIT);
+	}
+}
+
+static void uart_callback(const struct device *dev, struct uart_event *evt,
+			  void *user_data)
+{
+	k_spinlock_key_t key;
+	size_t pending;
+	int next = -1;
+
+	ARG_UNUSED(dev);
+	ARG_UNUSED(user_data);
+
+	if ((evt->type != UART_TX_DONE) && (evt->type != UART_TX_ABORTED)) {
+		return;
+	}
+
+	if (evt->type == UART_TX_ABORTED) {
+		LOG_WRN("Batch aborted after %zu bytes", evt->data.tx.len);
+	}
+
+	key = k_spin_lock(&lock);
+
+	buf_len[tx_buf] = 0U;
+	buf_lost[tx_buf] = 0U;
+	tx_buf = (tx_buf == 0) ? 1 : 0;
+	if (buf_len[tx_buf] != 0U) {
+		next = tx_buf;
+	} else {
+		tx_buf = -1;
+	}
+	pending = queue_count;
+
+	k_spin_unlock(&lock, key);
+
+	if (next >= 0) {
+		tx_start(next);
+	}
+
+	/* A buffer is free again */
+	if (pending > 0U) {
+		(void)k_work_reschedule(&flush_work, K_NO_WAIT);
+	}
+}
+
+static int telemetry_init(void)
+{
+	int ret;
+
+	if (!device_is_ready(uart)) {
+		LOG_ERR("UART not ready");
+		return -ENODEV;
+	}
+
+	ret = uart_callback_set(uart, uart_callback, NULL);
+	if (ret < 0) {
+		LOG_ERR("Could not set UART callback (%d)", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+SYS_INIT(telemetry_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -2,15 +2,41 @@
 #
 # SPDX-License-Identifier: Apache-2.0
 
+'''Runner for native_sim builds, in accelerated time.
+
+The simulated time of native_sim does not need to follow the host clock: with
+-no-rt it advances as fast as the host can run the application, so that the
+100 ms control loop or a soak test of several hours complete in seconds.'''
+
+import os
+import re
+import subprocess
+import sys
+import time
+
 from runners.core import RunnerCaps, ZephyrBinaryRunner
 
+# Printed by native_sim on exit
+STOPPED_AT_RE = re.compile(r'Stopped at (\d+(?:\.\d+)?)s')
+
+# The console UART is a pseudo-terminal otherwise, which ignores stdin
+STDINOUT_CONFIG = "CONFIG_UART_NATIVE_PTY_0_ON_STDINOUT"
+
 
 class ExampleRunner(ZephyrBinaryRunner):
-    """Dummy example runner."""
+    """Runs native_sim executables in accelerated time."""
 
-    def __init__(self, cfg, param):
+    def __init__(self, cfg, param=None, stop_at=None, real_time=False,
+                 trace_file=None, input_file=None, output_file=None,
+                 sim_args=None):
         super().__init__(cfg)
         self.param = param
+        self.stop_at = stop_at
+        self.real_time = real_time
+        self.trace_file = trace_file
+        self.input_file = input_file
+        self.output_file = output_file
+        self.sim_args = sim_args or []
 
     @classmethod
     def name(cls):
@@ -23,10 +49,123 @@ class ExampleRunner(ZephyrBinaryRunner):
     @classmethod
     def do_add_parser(cls, parser):
         parser.add_argument("--param", action="store", help="An example parameter")
+        parser.add_argument("--stop-at", type=float, metavar="SECONDS",
+                            help="stop after this much simulated time")
+        parser.add_argument("--real-time", action="store_true",
+                            help="keep the simulated time in step with the "
+                                 "host clock")
+        parser.add_argument("--trace-file", metavar="PATH",
+                            help="write the CTF trace to this file, for "
+                                 "builds with the tracing.conf fragment")
+        parser.add_argument("--input", dest="input_file", metavar="FILE",
+                            help="feed this file to the console input, "
+                                 f"needs a build with {STDINOUT_CONFIG}=y")
+        parser.add_argument("--output", dest="output_file", metavar="FILE",
+                            help="also write the console output to this file")
+        parser.add_argument("--sim-arg", dest="sim_args", action="append",
+                            metavar="ARG",
+                            help="extra zephyr.exe argument, may be repeated")
 
     @classmethod
     def do_create(cls, cfg, args):
-        return cls(cfg, param=args.param)
+        return cls(cfg, param=args.param, stop_at=args.stop_at,
+                   real_time=args.real_time, trace_file=args.trace_file,
+                   input_file=args.input_file, output_file=args.output_file,
+                   sim_args=args.sim_args)
+
+    def sim_command(self):
+        cmd = [self.cfg.exe_file]
+
+        if not self.real_time:
+            cmd.append("-no-rt")
+        if self.stop_at is not None:
+            cmd.append(f"-stop_at={self.stop_at}")
+        if self.trace_file is not None:
+            cmd.append(f"-trace-file={self.trace_file}")
+
+        return cmd + self.sim_args
+
+    def console_on_stdinout(self):
+        config = os.path.join(self.cfg.build_dir, "zephyr", ".config")
+        try:
+            with open(config) as f:
+                return f"{STDINOUT_CONFIG}=y\n" in f.read()
+        except OSError:
+            return False
 
     def do_run(self, command, **kwargs):
-        self.logger.info(f"Running {command} on {self.param}")
+        if self.param is not None:
+            self.logger.info(f"Running {command} on {self.param}")
+
+        exe = self.cfg.exe_file
+        if exe is None or not os.path.isfile(exe):
+            raise RuntimeError(f"no native executable {exe}, "
+                               "build the application for native_sim")
+
+        if self.input_file is not None and not self.console_on_stdinout():
+            raise RuntimeError(f"--input needs a build with {STDINOUT_CONFIG}"
+                               "=y, the console is not read from stdin "
+                               "otherwise")
+
+        cmd = self.sim_command()
+        self.logger.debug(" ".join(cmd))
+
+        stdin = subprocess.DEVNULL
+        if self.input_file is not None:
+            stdin = open(self.input_file, "rb")
+        output = None
+        if self.output_file is not None:
+            output = open(self.output_file, "w")
+
+        simulated_s = None
+        interrupted = False
+        start = time.monotonic()
+
+        def emit(line):
+            nonlocal simulated_s
+
+            sys.stdout.write(line)
+            if output is not None:
+                output.write(line)
+
+            match = STOPPED_AT_RE.search(line)
+            if match:
+                simulated_s = float(match.group(1))
+
+        try:
+            proc = subprocess.Popen(cmd, stdin=stdin, stdout=subprocess.PIPE,
+                                    stderr=subprocess.STDOUT, text=True,
+                                    errors="replace")
+            try:
+                for line in proc.stdout:
+                    emit(line)
+            except KeyboardInterrupt:
+                # native_sim prints the simulated time when interrupted too
+                interrupted = True
+                proc.terminate()
+                for line in proc.stdout:
+                    emit(line)
+            returncode = proc.wait()
+        finally:
+            if stdin is not subprocess.DEVNULL:
+                stdin.close()
+            if output is not None:
+                output.close()
+
+        wall_s = time.monotonic() - start
+
+        if simulated_s is None and self.stop_at is not None and \
+                returncode == 0:
+            simulated_s = self.stop_at
+
+        if simulated_s is None:
+            self.logger.info(f"{wall_s:.3f} s wall clock, simulated time "
+                             "unknown")
+        else:
+            speedup = simulated_s / wall_s if wall_s > 0 else float("inf")
+            self.logger.info(f"simulated {simulated_s:.3f} s in "
+                             f"{wall_s:.3f} s wall clock, "
+                             f"speedup x{speedup:.1f}")
+
+        if returncode != 0 and not interrupted:
+            raise subprocess.CalledProcessError(returncode, cmd)
@@ -0,0 +1,86 @@
+# Copyright (c) 2022 Nordic Semiconductor ASA
+# SPDX-License-Identifier: Apache-2.0
+
+'''log_decode_west_command.py
+
+West extension to decode dictionary-based log output on the host.'''
+
+import argparse
+import binascii
+import logging
+import os
+import sys
+from pathlib import Path
+
+from west.commands import WestCommand  # your extension must subclass this
+from west import log                   # use this for user output
+
+class LogDecodeWestCommand(WestCommand):
+
+    def __init__(self):
+        super().__init__(
+            'log-decode',
+            'decode dictionary-based log output',
+            '''\
+Decode the output of a build using dictionary-based logging (see
+app/logging_dict.conf) into human readable log messages.
+
+The log stream is read from a file, or from standard input when no file is
+given. By default the log database generated by the build is taken from the
+build directory.''')
+
+    def do_add_parser(self, parser_adder):
+        parser = parser_adder.add_parser(
+            self.name, help=self.help,
+            formatter_class=argparse.RawDescriptionHelpFormatter,
+            description=self.description)
+
+        parser.add_argument('-d', '--build-dir', default='build',
+                            help='build directory (default: build)')
+        parser.add_argument('--database',
+                            help='log database, overrides --build-dir')
+        parser.add_argument('--hex', action='store_true',
+                            help='log stream is hexadecimal text, as output '
+                                 'by the UART backend in hex mode')
+        parser.add_argument('--debug', action='store_true',
+                            help='print decoder debug information')
+        parser.add_argument('input', nargs='?',
+                            help='log stream file (default: stdin)')
+
+        return parser
+
+    def do_run(self, args, unknown_args):
+        sys.path.append(str(self._zephyr_base() / 'scripts' / 'logging' /
+                            'dictionary'))
+        import dictionary_parser
+        from dictionary_parser.log_database import LogDatabase
+
+        dbfile = args.database or os.path.join(args.build_dir, 'zephyr',
+                                               'log_dictionary.json')
+        database = LogDatabase.read_json_database(dbfile)
+        if database is None:
+            log.die(f'could not read log database {dbfile}')
+
+        if args.input:
+            with open(args.input, 'rb') as f:
+                logdata = f.read()
+        else:
+            logdata = sys.stdin.buffer.read()
+
+        if args.hex:
+            logdata = binascii.unhexlify(b''.join(logdata.split()))
+
+        logging.basicConfig(format='%(message)s', level=logging.INFO)
+
+        parser = dictionary_parser.get_parser(database)
+        if parser is None:
+            log.die('log database version is not supported')
+
+        if not parser.parse_log_data(logdata, debug=args.debug):
+            log.die('could not decode the log stream')
+
+    def _zephyr_base(self):
+        if 'ZEPHYR_BASE' in os.environ:
+            return Path(os.environ['ZEPHYR_BASE'])
+
+        return Path(self.manifest.get_projects(['zephyr'])[0].abspath)
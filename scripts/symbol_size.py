@@ -0,0 +1,37 @@
+# Copyright (c) 2024 Nordic Semiconductor ASA
+# SPDX-License-Identifier: Apache-2.0
+
+'''symbol_size.py
+
+Print the ROM size of selected function symbols of a Zephyr ELF image, so
+that benchmarks can report footprint next to their cycle counts.'''
+
+import argparse
+import sys
+
+from elftools.elf.elffile import ELFFile
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('elf', help='ELF image to inspect')
+    parser.add_argument('symbols', nargs='+', help='symbols to report')
+    args = parser.parse_args()
+
+    sizes = {}
+    with open(args.elf, 'rb') as f:
+        symtab = ELFFile(f).get_section_by_name('.symtab')
+        if symtab is None:
+            sys.exit(f'{args.elf}: no symbol table')
+
+        for sym in symtab.iter_symbols():
+            if sym.name in args.symbols:
+                sizes[sym.name] = sizes.get(sym.name, 0) + sym['st_size']
+
+    for name in args.symbols:
+        size = sizes.get(name)
+        print(f'{name}: {size if size is not None else "inlined"} bytes')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,182 @@
+# Copyright (c) 2024 Nordic Semiconductor ASA
+# SPDX-License-Identifier: Apache-2.0
+
+'''telemetry_decode.py
+
+Decode the CBOR telemetry frames sent by the telemetry library (see
+include/app/lib/telemetry.h) from a capture file or a serial port, and print
+one line per record. Bytes outside of valid frames, such as console text on
+a shared UART, are skipped.'''
+
+import argparse
+import struct
+import sys
+
+FRAME_MAGIC = 0xCB
+FRAME_HEADER = struct.Struct('<BH')
+
+TYPES = {0: 'edge', 1: 'period', 2: 'stats'}
+
+_BREAK = object()
+
+
+class DecodeError(Exception):
+    pass
+
+
+def _cbor_item(data, pos):
+    '''Decode the CBOR item at pos, return (item, next_pos).
+
+    Only the subset used by the firmware is supported: integers and definite
+    or indefinite length arrays.'''
+    if pos >= len(data):
+        raise DecodeError('truncated')
+
+    initial = data[pos]
+    major, info = initial >> 5, initial & 0x1F
+    pos += 1
+
+    if initial == 0xFF:
+        return _BREAK, pos
+
+    if info < 24:
+        arg = info
+    elif info in (24, 25, 26, 27):
+        size = 1 << (info - 24)
+        if pos + size > len(data):
+            raise DecodeError('truncated')
+        arg = int.from_bytes(data[pos:pos + size], 'big')
+        pos += size
+    elif info == 31 and major == 4:
+        arg = None
+    else:
+        raise DecodeError(f'unsupported initial byte 0x{initial:02x}')
+
+    if major == 0:
+        return arg, pos
+    if major == 1:
+        return -1 - arg, pos
+    if major == 4:
+        items = []
+        while arg is None or len(items) < arg:
+            item, pos = _cbor_item(data, pos)
+            if item is _BREAK:
+                if arg is not None:
+                    raise DecodeError('unexpected break')
+                break
+            items.append(item)
+        return items, pos
+
+    raise DecodeError(f'unsupported major type {major}')
+
+
+def decode_payload(payload):
+    '''Decode a frame payload into (seq, base_ms, dropped, records).'''
+    batch, end = _cbor_item(payload, 0)
+    if end != len(payload) or not isinstance(batch, list) or len(batch) != 4:
+        raise DecodeError('malformed batch')
+
+    seq, base_ms, dropped, records = batch
+    decoded = []
+    for rec in records:
+        if not isinstance(rec, list) or len(rec) < 3:
+            raise DecodeError('malformed record')
+        rtype, delta_ms, rid, *values = rec
+        decoded.append((base_ms + delta_ms, TYPES.get(rtype, str(rtype)),
+                        rid, values))
+
+    return seq, base_ms, dropped, decoded
+
+
+def frames(data, final=True):
+    '''Yield (payload, end) for each valid frame in data.
+
+    Unless final is set, decoding stops at a frame that may still be
+    incomplete, so that it can be retried once more data is available.'''
+    pos = 0
+    while pos + FRAME_HEADER.size <= len(data):
+        if data[pos] != FRAME_MAGIC:
+            pos += 1
+            continue
+
+        _, length = FRAME_HEADER.unpack_from(data, pos)
+        start = pos + FRAME_HEADER.size
+        payload = data[start:start + length]
+        if len(payload) < length:
+            if not final:
+                break
+            pos += 1
+            continue
+
+        try:
+            decode_payload(payload)
+        except DecodeError:
+            # Not a frame, resynchronize on the next byte
+            pos += 1
+            continue
+
+        pos = start + length
+        yield payload, pos
+
+
+def print_batch(payload, last_seq):
+    seq, _, dropped, records = decode_payload(payload)
+
+    if last_seq is not None and seq != (last_seq + 1) & 0xFFFFFFFF:
+        print(f'# batches {last_seq + 1}..{seq - 1} lost')
+    if dropped:
+        print(f'# {dropped} records dropped on target')
+
+    for uptime_ms, rtype, rid, values in records:
+        print(f'{uptime_ms:10d} ms {rtype:6s} {rid:3d} '
+              f'{" ".join(str(v) for v in values)}')
+
+    return seq
+
+
+def read_serial(port, baudrate):
+    try:
+        import serial
+    except ImportError:
+        sys.exit('pyserial is required to read from a serial port')
+
+    with serial.Serial(port, baudrate, timeout=0.1) as ser:
+        data = bytearray()
+        last_seq = None
+        while True:
+            data += ser.read(256)
+            end = 0
+            for payload, end in frames(data, final=False):
+                last_seq = print_batch(payload, last_seq)
+            # Keep at most one maximum size frame of unparsed data
+            end = max(end, len(data) - FRAME_HEADER.size - 0xFFFF)
+            del data[:end]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('input', help='capture file, or serial port with '
+                        '--serial')
+    parser.add_argument('--serial', action='store_true',
+                        help='read from a serial port until interrupted')
+    parser.add_argument('--baudrate', type=int, default=115200,
+                        help='serial port baud rate (default: 115200)')
+    args = parser.parse_args()
+
+    if args.serial:
+        try:
+            read_serial(args.input, args.baudrate)
+        except KeyboardInterrupt:
+            pass
+        return
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+
+    last_seq = None
+    for payload, _ in frames(data):
+        last_seq = print_batch(payload, last_seq)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,129 @@
+# Copyright (c) 2024 Nordic Semiconductor ASA
+# SPDX-License-Identifier: Apache-2.0
+
+'''trace_stats_west_command.py
+
+West extension to analyze CTF traces of the example application trace
+points (see include/app/tracing.h).'''
+
+import argparse
+import os
+import shutil
+import statistics
+from pathlib import Path
+
+from west.commands import WestCommand  # your extension must subclass this
+from west import log                   # use this for user output
+
+# Stages measured between consecutive trace points: (name, start, end)
+STAGES = (
+    ('fetch', 'sensor_fetch_start', 'sensor_fetch_end'),
+    ('decision', 'sensor_fetch_end', 'edge_detected'),
+    ('period update', 'edge_detected', 'period_change'),
+    ('first toggle', 'period_change', 'blink_toggle'),
+)
+
+class TraceStatsWestCommand(WestCommand):
+
+    def __init__(self):
+        super().__init__(
+            'trace-stats',
+            'analyze example application CTF traces',
+            '''\
+Compute per-stage latency statistics from a CTF trace recorded with
+app/tracing.conf, for instance on native_sim:
+
+  west build -b native_sim app -- -DEXTRA_CONF_FILE=tracing.conf
+  ./build/zephyr/zephyr.exe -trace-file=trace/channel0_0
+  west trace-stats trace
+
+The stages are sensor fetch, fetch to edge decision, edge to period
+change and period change to the next LED toggle. Use --timeline to
+also print every trace point. Requires the babeltrace2 Python
+bindings.''')
+
+    def do_add_parser(self, parser_adder):
+        parser = parser_adder.add_parser(
+            self.name, help=self.help,
+            formatter_class=argparse.RawDescriptionHelpFormatter,
+            description=self.description)
+
+        parser.add_argument('--timeline', action='store_true',
+                            help='print the timeline of trace points')
+        parser.add_argument('trace', help='directory containing the trace')
+
+        return parser
+
+    def do_run(self, args, unknown_args):
+        try:
+            import bt2
+        except ImportError:
+            log.die('babeltrace2 Python bindings are required')
+
+        self._ensure_metadata(Path(args.trace))
+
+        events = []
+        for msg in bt2.TraceCollectionMessageIterator(args.trace):
+            if type(msg) is not bt2._EventMessageConst:
+                continue
+            if msg.event.name != 'named_event':
+                continue
+
+            payload = msg.event.payload_field
+            events.append((msg.default_clock_snapshot.ns_from_origin,
+                           str(payload['name']), int(payload['arg0']),
+                           int(payload['arg1'])))
+
+        if not events:
+            log.die('no application trace points found, was the build '
+                    'configured with CONFIG_EXAMPLE_TRACING?')
+
+        if args.timeline:
+            self._print_timeline(events)
+
+        self._print_stats(events)
+
+    def _ensure_metadata(self, trace):
+        # The CTF backend only records the binary stream, the metadata
+        # describing it lives in the Zephyr tree.
+        if (trace / 'metadata').exists():
+            return
+
+        zephyr_base = os.environ.get('ZEPHYR_BASE') or \
+            self.manifest.get_projects(['zephyr'])[0].abspath
+        metadata = Path(zephyr_base) / 'subsys' / 'tracing' / 'ctf' / \
+            'tsdl' / 'metadata'
+        log.inf(f'copying {metadata} to {trace}')
+        shutil.copy(metadata, trace)
+
+    def _print_timeline(self, events):
+        origin = events[0][0]
+        prev = origin
+        for ns, name, arg0, arg1 in events:
+            log.inf(f'{(ns - origin) / 1000:12.1f} us '
+                    f'(+{(ns - prev) / 1000:10.1f}) '
+                    f'{name:<20} {arg0:#010x} {arg1}')
+            prev = ns
+
+    def _print_stats(self, events):
+        log.inf(f'{"stage":<16}{"count":>8}{"min us":>12}{"mean us":>12}'
+                f'{"max us":>12}')
+
+        for stage, start, end in STAGES:
+            latencies = []
+            started = None
+            for ns, name, _, _ in events:
+                if name == start:
+                    started = ns
+                elif name == end and started is not None:
+                    latencies.append((ns - started) / 1000)
+                    started = None
+
+            if not latencies:
+                log.inf(f'{stage:<16}{0:>8}')
+                continue
+
+            log.inf(f'{stage:<16}{len(latencies):>8}'
+                    f'{min(latencies):>12.1f}'
+                    f'{statistics.mean(latencies):>12.1f}'
+                    f'{max(latencies):>12.1f}')
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file benchmark control_map scaling
+ *
+ * This suite measures the memory and CPU cost of the control loop as a
+ * function of the number of sensor to LED pairs. Run the scenarios in
+ * testcase.yaml to compare 1, 4 and 16 pairs. Each control step sees every
+ * pair toggle, half of them being proximity edges that update a LED period.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/ztest.h>
+
+#include <app/lib/control_map.h>
+#include <app/lib/edge_detect.h>
+
+#define NUM_ITERATIONS 1000U
+#define NUM_PAIRS      CONTROL_MAP_NUM_PAIRS
+#define NUM_WORDS      EDGE_DETECT_WORDS(NUM_PAIRS)
+
+static edge_detect_word_t levels[2][NUM_WORDS];
+
+static void report(const char *name, timing_t start, timing_t end)
+{
+	uint64_t cycles = timing_cycles_get(&start, &end) / NUM_ITERATIONS;
+
+	TC_PRINT("%s: %u pairs, %u cycles per step, %u cycles per pair\n",
+		 name, (unsigned int)NUM_PAIRS, (uint32_t)cycles,
+		 (uint32_t)(cycles / NUM_PAIRS));
+}
+
+ZTEST(control_map_benchmark, test_memory)
+{
+	/* Period per pair, plus the edge detector level and history bits, as
+	 * accounted by control_map_init()
+	 */
+	size_t ram = NUM_PAIRS * sizeof(unsigned int) +
+		     2U * NUM_WORDS * sizeof(edge_detect_word_t);
+
+	TC_PRINT("memory: %u pairs, %zu bytes ROM table, %zu bytes RAM\n",
+		 (unsigned int)NUM_PAIRS, sizeof(control_map_pairs), ram);
+}
+
+ZTEST(control_map_benchmark, test_update)
+{
+	timing_t start, end;
+	size_t changes = 0U;
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < NUM_ITERATIONS; i++) {
+		changes += control_map_update(levels[i & 1U]);
+	}
+	end = timing_counter_get();
+
+	zassert_equal(changes, NUM_ITERATIONS / 2U * NUM_PAIRS);
+
+	report("update", start, end);
+}
+
+ZTEST(control_map_benchmark, test_step)
+{
+	struct sensor_value val;
+	timing_t start, end;
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < NUM_ITERATIONS; i++) {
+		edge_detect_word_t *step = levels[i & 1U];
+
+		/* Same reads as the polling control loop */
+		for (size_t n = 0U; n < NUM_PAIRS; n++) {
+			const struct device *dev = control_map_pairs[n].sensor;
+
+			(void)sensor_sample_fetch(dev);
+			(void)sensor_channel_get(dev, SENSOR_CHAN_PROX, &val);
+		}
+
+		(void)control_map_update(step);
+	}
+	end = timing_counter_get();
+
+	report("step", start, end);
+}
+
+static void *control_map_benchmark_setup(void)
+{
+	zassert_ok(control_map_init());
+
+	for (size_t n = 0U; n < NUM_PAIRS; n++) {
+		levels[1][n / EDGE_DETECT_WORD_BITS] |=
+			(edge_detect_word_t)1U << (n % EDGE_DETECT_WORD_BITS);
+	}
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void control_map_benchmark_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(control_map_benchmark, NULL, control_map_benchmark_setup, NULL,
+	    NULL, control_map_benchmark_teardown);
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file benchmark driver hot paths
+ *
+ * This suite measures the cost, in cycles, of the operations that run on
+ * every control loop iteration or LED toggle: example_sensor sample fetch and
+ * the blink_gpio_led timer expiry handler. Run the different scenarios in
+ * testcase.yaml to compare driver build options.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/ztest.h>
+
+#include <app/drivers/blink.h>
+#include <app/drivers/blink/gpio_led.h>
+
+#define NUM_ITERATIONS 1000U
+
+static const struct device *const sensor =
+	DEVICE_DT_GET(DT_NODELABEL(example_sensor));
+static const struct device *const blink =
+	DEVICE_DT_GET(DT_NODELABEL(blink_led));
+
+static uint32_t cycles_per_iteration(timing_t start, timing_t end)
+{
+	return (uint32_t)(timing_cycles_get(&start, &end) / NUM_ITERATIONS);
+}
+
+ZTEST(driver_benchmark, test_sample_fetch)
+{
+	timing_t start, end;
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < NUM_ITERATIONS; i++) {
+		(void)sensor_sample_fetch(sensor);
+	}
+	end = timing_counter_get();
+
+	TC_PRINT("sample_fetch: %u cycles\n", cycles_per_iteration(start, end));
+}
+
+ZTEST(driver_benchmark, test_toggle_isr)
+{
+	timing_t start, end;
+	unsigned int key;
+
+	zassert_ok(blink_off(blink));
+
+	/* Run the expiry handler directly, as the timer ISR would */
+	key = irq_lock();
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < NUM_ITERATIONS; i++) {
+		blink_gpio_led_timer_expire(blink);
+	}
+	end = timing_counter_get();
+	irq_unlock(key);
+
+	TC_PRINT("toggle_isr: %u cycles\n", cycles_per_iteration(start, end));
+}
+
+static void *driver_benchmark_setup(void)
+{
+	zassert_true(device_is_ready(sensor), "sensor not ready");
+	zassert_true(device_is_ready(blink), "blink LED not ready");
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void driver_benchmark_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(driver_benchmark, NULL, driver_benchmark_setup, NULL, NULL,
+	    driver_benchmark_teardown);
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file benchmark edge_detect throughput
+ *
+ * This suite measures the cost, in cycles, of sampling and detecting edges on
+ * 256 inputs spread over eight GPIO ports, for the edge_detect library and
+ * for the equivalent per-input code (one pin read and one comparison per
+ * input), as main.c used to do for its single input.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/ztest.h>
+
+#include <app/lib/edge_detect.h>
+
+#define NUM_ITERATIONS 1000U
+#define NUM_PORTS      8U
+#define NUM_INPUTS     (NUM_PORTS * GPIO_MAX_PINS_PER_PORT)
+#define NUM_WORDS      EDGE_DETECT_WORDS(NUM_INPUTS)
+
+#define PORT_GET(i, _) DEVICE_DT_GET(DT_NODELABEL(UTIL_CAT(gpio_emul, i)))
+
+static const struct device *const ports[NUM_PORTS] = {
+	LISTIFY(8, PORT_GET, (,))
+};
+
+EDGE_DETECT_DEFINE(raw, NUM_INPUTS, 1, 1);
+EDGE_DETECT_DEFINE(majority, NUM_INPUTS, 5, 3);
+
+static edge_detect_word_t samples[2][NUM_WORDS];
+static edge_detect_word_t rising[NUM_WORDS];
+static edge_detect_word_t falling[NUM_WORDS];
+
+static uint8_t levels[2][NUM_INPUTS];
+static uint8_t last_levels[NUM_INPUTS];
+static uint8_t scalar_rising[NUM_INPUTS];
+
+static void report(const char *name, timing_t start, timing_t end)
+{
+	uint64_t cycles = timing_cycles_get(&start, &end) / NUM_ITERATIONS;
+
+	TC_PRINT("%s: %u cycles per call, %u cycles per 100 inputs\n", name,
+		 (uint32_t)cycles, (uint32_t)(cycles * 100U / NUM_INPUTS));
+}
+
+static void bench_update(const char *name, struct edge_detect *ed)
+{
+	timing_t start, end;
+
+	edge_detect_reset(ed, NULL);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < NUM_ITERATIONS; i++) {
+		(void)edge_detect_update(ed, samples[i & 1U], rising, falling,
+					 NULL);
+	}
+	end = timing_counter_get();
+
+	report(name, start, end);
+}
+
+ZTEST(edge_detect_benchmark, test_update_raw)
+{
+	bench_update("update_raw", &raw);
+}
+
+ZTEST(edge_detect_benchmark, test_update_majority)
+{
+	bench_update("update_majority_5", &majority);
+}
+
+ZTEST(edge_detect_benchmark, test_update_scalar)
+{
+	timing_t start, end;
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < NUM_ITERATIONS; i++) {
+		const uint8_t *val = levels[i & 1U];
+
+		for (size_t n = 0U; n < NUM_INPUTS; n++) {
+			scalar_rising[n] = (last_levels[n] == 0U) &&
+					   (val[n] == 1U);
+			last_levels[n] = val[n];
+		}
+	}
+	end = timing_counter_get();
+
+	report("update_scalar", start, end);
+}
+
+ZTEST(edge_detect_benchmark, test_sample_ports)
+{
+	timing_t start, end;
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < NUM_ITERATIONS; i++) {
+		zassert_ok(edge_detect_sample_ports(ports, NUM_PORTS,
+						    samples[0]));
+	}
+	end = timing_counter_get();
+
+	report("sample_ports", start, end);
+}
+
+ZTEST(edge_detect_benchmark, test_sample_pins)
+{
+	timing_t start, end;
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < NUM_ITERATIONS; i++) {
+		for (size_t n = 0U; n < NUM_INPUTS; n++) {
+			levels[0][n] = (uint8_t)gpio_pin_get_raw(
+				ports[n / GPIO_MAX_PINS_PER_PORT],
+				n % GPIO_MAX_PINS_PER_PORT);
+		}
+	}
+	end = timing_counter_get();
+
+	report("sample_pins", start, end);
+}
+
+static void *edge_detect_benchmark_setup(void)
+{
+	for (size_t p = 0U; p < NUM_PORTS; p++) {
+		zassert_true(device_is_ready(ports[p]), "port %zu not ready",
+			     p);
+	}
+
+	/* Alternate between two snapshots where a quarter of inputs toggle */
+	for (size_t n = 0U; n < NUM_INPUTS; n++) {
+		uint8_t level = ((n % 4U) == 0U) ? 1U : 0U;
+
+		levels[1][n] = level;
+		samples[1][n / EDGE_DETECT_WORD_BITS] |=
+			(edge_detect_word_t)level << (n % EDGE_DETECT_WORD_BITS);
+	}
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void edge_detect_benchmark_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(edge_detect_benchmark, NULL, edge_detect_benchmark_setup, NULL,
+	    NULL, edge_detect_benchmark_teardown);
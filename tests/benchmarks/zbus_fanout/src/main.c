@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file benchmark zbus sample fan-out
+ *
+ * This suite measures the cost, in cycles, of publishing a control_map sample
+ * on a zbus channel observed by 1, 4 and 16 listeners (run synchronously,
+ * reading the sample in place) or subscribers (queued channel reference,
+ * read later in place). The sample is stored once in the channel whatever
+ * the number of observers.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+
+#include <app/lib/control_map.h>
+
+#define NUM_ITERATIONS 1000U
+#define SUB_QUEUE_SIZE 4
+
+static volatile edge_detect_word_t sink;
+
+static void listener_cb(const struct zbus_channel *chan)
+{
+	const struct control_map_sample *sample = zbus_chan_const_msg(chan);
+
+	sink ^= sample->rising[0];
+}
+
+#define LISTENER_DEFINE(i, _)                                                  \
+	ZBUS_LISTENER_DEFINE(listener##i, listener_cb);
+#define SUBSCRIBER_DEFINE(i, _)                                                \
+	ZBUS_SUBSCRIBER_DEFINE(subscriber##i, SUB_QUEUE_SIZE);
+
+LISTIFY(16, LISTENER_DEFINE, ())
+LISTIFY(16, SUBSCRIBER_DEFINE, ())
+
+#define LISTENER_NAME(i, _)   listener##i
+#define SUBSCRIBER_NAME(i, _) subscriber##i
+
+#define FANOUT_CHAN_DEFINE(name, n, obs)                                       \
+	ZBUS_CHAN_DEFINE(name, struct control_map_sample, NULL, NULL,          \
+			 ZBUS_OBSERVERS(LISTIFY(n, obs, (,))), ZBUS_MSG_INIT(0))
+
+FANOUT_CHAN_DEFINE(listener_chan_1, 1, LISTENER_NAME);
+FANOUT_CHAN_DEFINE(listener_chan_4, 4, LISTENER_NAME);
+FANOUT_CHAN_DEFINE(listener_chan_16, 16, LISTENER_NAME);
+FANOUT_CHAN_DEFINE(subscriber_chan_1, 1, SUBSCRIBER_NAME);
+FANOUT_CHAN_DEFINE(subscriber_chan_4, 4, SUBSCRIBER_NAME);
+FANOUT_CHAN_DEFINE(subscriber_chan_16, 16, SUBSCRIBER_NAME);
+
+#define SUBSCRIBER_REF(i, _) &subscriber##i
+
+static const struct zbus_observer *const subscribers[] = {
+	LISTIFY(16, SUBSCRIBER_REF, (,))
+};
+
+/* Consume the channel references queued to the first n subscribers */
+static void subscribers_drain(size_t n)
+{
+	const struct zbus_channel *chan;
+
+	for (size_t i = 0U; i < n; i++) {
+		while (zbus_sub_wait(subscribers[i], &chan, K_NO_WAIT) == 0) {
+			const struct control_map_sample *sample;
+
+			zassert_ok(zbus_chan_claim(chan, K_NO_WAIT));
+			sample = zbus_chan_const_msg(chan);
+			sink ^= sample->rising[0];
+			zassert_ok(zbus_chan_finish(chan));
+		}
+	}
+}
+
+static void bench_publish(const char *name, const struct zbus_channel *chan,
+			  size_t num_subscribers)
+{
+	struct control_map_sample sample = {0};
+	uint64_t cycles = 0U;
+	timing_t start, end;
+
+	for (uint32_t i = 0; i < NUM_ITERATIONS; i++) {
+		sample.uptime_ms = i;
+		sample.rising[0] = i & 1U;
+
+		start = timing_counter_get();
+		zassert_ok(zbus_chan_pub(chan, &sample, K_NO_WAIT));
+		end = timing_counter_get();
+
+		cycles += timing_cycles_get(&start, &end);
+
+		subscribers_drain(num_subscribers);
+	}
+
+	TC_PRINT("%s: %u cycles per publish, %zu bytes message\n", name,
+		 (uint32_t)(cycles / NUM_ITERATIONS), sizeof(sample));
+}
+
+ZTEST(zbus_fanout_benchmark, test_listeners)
+{
+	bench_publish("listeners_1", &listener_chan_1, 0U);
+	bench_publish("listeners_4", &listener_chan_4, 0U);
+	bench_publish("listeners_16", &listener_chan_16, 0U);
+}
+
+ZTEST(zbus_fanout_benchmark, test_subscribers)
+{
+	bench_publish("subscribers_1", &subscriber_chan_1, 1U);
+	bench_publish("subscribers_4", &subscriber_chan_4, 4U);
+	bench_publish("subscribers_16", &subscriber_chan_16, 16U);
+}
+
+static void *zbus_fanout_benchmark_setup(void)
+{
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void zbus_fanout_benchmark_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(zbus_fanout_benchmark, NULL, zbus_fanout_benchmark_setup, NULL,
+	    NULL, zbus_fanout_benchmark_teardown);
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test blink_gpio_led performance counters
+ *
+ * This suite blinks the LED on an emulated GPIO and checks the timer expiry
+ * and period change counters of the LED stats group.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/stats/stats.h>
+#include <zephyr/ztest.h>
+
+#include <app/drivers/blink.h>
+#include <app/drivers/blink/gpio_led.h>
+
+#define PERIOD_MS   10U
+#define NUM_PERIODS 10U
+
+static const struct device *const led = DEVICE_DT_GET(DT_NODELABEL(blink_led));
+
+static STATS_SECT_DECL(blink_gpio_led_counters) *counters;
+
+ZTEST(blink_counters, test_expiries)
+{
+	uint32_t expiries = counters->timer_expiries;
+	uint32_t changes = counters->period_changes;
+
+	zassert_ok(blink_set_period_ms(led, PERIOD_MS));
+	k_msleep(PERIOD_MS * NUM_PERIODS + PERIOD_MS / 2U);
+	zassert_ok(blink_off(led));
+
+	zassert_within(counters->timer_expiries - expiries, NUM_PERIODS, 1U);
+	zassert_equal(counters->period_changes, changes + 2U);
+	zassert_equal(counters->toggle_failures, 0U);
+
+	/* Stopped */
+	expiries = counters->timer_expiries;
+	k_msleep(PERIOD_MS * 2U);
+	zassert_equal(counters->timer_expiries, expiries);
+
+	/* Turning off again is not a change */
+	zassert_ok(blink_off(led));
+	zassert_equal(counters->period_changes, changes + 2U);
+}
+
+static void *blink_counters_setup(void)
+{
+	struct stats_hdr *hdr;
+
+	zassert_true(device_is_ready(led));
+
+	hdr = stats_group_find(led->name);
+	zassert_not_null(hdr, "no group for %s", led->name);
+	counters = CONTAINER_OF(hdr, STATS_SECT_DECL(blink_gpio_led_counters),
+				s_hdr);
+
+	return NULL;
+}
+
+ZTEST_SUITE(blink_counters, NULL, blink_counters_setup, NULL, NULL, NULL);
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test nRF TIMER, PPI and GPIOTE blink driver
+ *
+ * This suite runs on nrf52_bsim. A second TIMER in counter mode counts the
+ * compare events of the LED TIMER through its own PPI channel, and checks
+ * them against the simulated time. The LED pin level is read back in the
+ * middle of each period, which checks that the GPIOTE task toggles it, and
+ * after blink_off(), which must leave the LED inactive. It also checks that
+ * blinking enables no interrupt.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/irq.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hal/nrf_gpio.h>
+#include <hal/nrf_timer.h>
+#include <helpers/nrfx_gppi.h>
+
+#include <app/drivers/blink.h>
+
+#define LED_NODE   DT_NODELABEL(blink_led)
+#define TIMER_NODE DT_PHANDLE(LED_NODE, timer)
+
+#define PERIOD_MS   10U
+#define NUM_PERIODS 20U
+
+static const struct device *const led = DEVICE_DT_GET(LED_NODE);
+static NRF_TIMER_Type *const led_timer =
+	(NRF_TIMER_Type *)DT_REG_ADDR(TIMER_NODE);
+/* Counts the LED TIMER compare events */
+static NRF_TIMER_Type *const counter =
+	(NRF_TIMER_Type *)DT_REG_ADDR(DT_NODELABEL(timer3));
+
+static const uint32_t led_pin = NRF_DT_GPIOS_TO_PSEL(LED_NODE, led_gpios);
+static const bool led_active_low =
+	(DT_GPIO_FLAGS(LED_NODE, led_gpios) & GPIO_ACTIVE_LOW) != 0;
+
+static bool led_is_active(void)
+{
+	return (nrf_gpio_pin_read(led_pin) != 0U) != led_active_low;
+}
+
+static uint32_t toggles_get(void)
+{
+	nrf_timer_task_trigger(counter, NRF_TIMER_TASK_CAPTURE0);
+
+	return nrf_timer_cc_get(counter, NRF_TIMER_CC_CHANNEL0);
+}
+
+static void toggles_clear(void)
+{
+	nrf_timer_task_trigger(counter, NRF_TIMER_TASK_CLEAR);
+}
+
+ZTEST(blink_nrf_led, test_period)
+{
+	toggles_clear();
+	zassert_ok(blink_set_period_ms(led, PERIOD_MS));
+
+	/* Half a period more, so that no toggle is on the edge */
+	k_msleep(NUM_PERIODS * PERIOD_MS + PERIOD_MS / 2U);
+	zassert_equal(toggles_get(), NUM_PERIODS);
+
+	/* A new period applies from the call */
+	toggles_clear();
+	zassert_ok(blink_set_period_ms(led, 2U * PERIOD_MS));
+	k_msleep(NUM_PERIODS * PERIOD_MS + PERIOD_MS);
+	zassert_equal(toggles_get(), NUM_PERIODS / 2U);
+
+	zassert_ok(blink_off(led));
+}
+
+ZTEST(blink_nrf_led, test_levels)
+{
+	zassert_false(led_is_active());
+	zassert_ok(blink_set_period_ms(led, PERIOD_MS));
+
+	/* Sampled in the middle of each period, toggled by each compare */
+	k_msleep(PERIOD_MS / 2U);
+	for (uint32_t i = 0U; i < NUM_PERIODS; i++) {
+		zassert_equal(led_is_active(), (i & 1U) != 0U, "period %u", i);
+		k_msleep(PERIOD_MS);
+	}
+
+	zassert_ok(blink_off(led));
+	zassert_false(led_is_active());
+}
+
+ZTEST(blink_nrf_led, test_off)
+{
+	/* Turned off while active, after an odd number of toggles */
+	zassert_ok(blink_set_period_ms(led, PERIOD_MS));
+	k_msleep(3U * PERIOD_MS + PERIOD_MS / 2U);
+	zassert_true(led_is_active());
+	zassert_ok(blink_off(led));
+	zassert_false(led_is_active());
+
+	toggles_clear();
+	k_msleep(NUM_PERIODS * PERIOD_MS);
+	zassert_equal(toggles_get(), 0U);
+	zassert_false(led_is_active());
+}
+
+ZTEST(blink_nrf_led, test_no_interrupts)
+{
+	zassert_ok(blink_set_period_ms(led, PERIOD_MS));
+	k_msleep(NUM_PERIODS * PERIOD_MS);
+
+	/* Toggles happen, without any interrupt to serve them */
+	zassert_true(toggles_get() > 0U);
+	zassert_equal(nrf_timer_int_enable_check(led_timer, ~0U), 0U);
+	zassert_false(irq_is_enabled(DT_IRQN(TIMER_NODE)));
+
+	zassert_ok(blink_off(led));
+}
+
+ZTEST(blink_nrf_led, test_invalid)
+{
+	zassert_equal(blink_set_period_ms(led, UINT32_MAX), -EINVAL);
+}
+
+static void *blink_nrf_led_setup(void)
+{
+	const nrf_gpio_pin_input_t input = NRF_GPIO_PIN_INPUT_CONNECT;
+	uint8_t ppi_ch;
+
+	zassert_true(device_is_ready(led));
+
+	/* The GPIOTE task drives the pin, the input buffer reads it back */
+	nrf_gpio_reconfigure(led_pin, NULL, &input, NULL, NULL, NULL);
+
+	nrf_timer_mode_set(counter, NRF_TIMER_MODE_COUNTER);
+	nrf_timer_bit_width_set(counter, NRF_TIMER_BIT_WIDTH_32);
+	nrf_timer_task_trigger(counter, NRF_TIMER_TASK_START);
+
+	zassert_equal(nrfx_gppi_channel_alloc(&ppi_ch), NRFX_SUCCESS);
+	nrfx_gppi_channel_endpoints_setup(
+		ppi_ch,
+		nrf_timer_event_address_get(led_timer,
+					    NRF_TIMER_EVENT_COMPARE0),
+		nrf_timer_task_address_get(counter, NRF_TIMER_TASK_COUNT));
+	nrfx_gppi_channels_enable(BIT(ppi_ch));
+
+	return NULL;
+}
+
+ZTEST_SUITE(blink_nrf_led, NULL, blink_nrf_led_setup, NULL, NULL, NULL);
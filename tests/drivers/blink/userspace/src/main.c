@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test blink driver class system calls
+ *
+ * This suite verifies that the blink system calls can be used from user mode
+ * threads, and that a batch with a bad device handle is rejected before any
+ * LED changes. It also reports the per-LED cost of single versus batched
+ * calls.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/stats/stats.h>
+#include <zephyr/ztest.h>
+
+#include <app/drivers/blink.h>
+#include <app/drivers/blink/gpio_led.h>
+
+#define BLINK_DEV(node_id) DEVICE_DT_GET(node_id),
+
+#define NUM_LEDS       DT_NUM_INST_STATUS_OKAY(blink_gpio_led)
+#define NUM_ITERATIONS 100U
+#define PERIOD_MS      1000U
+
+/* Entries checked by the system call handler at a time */
+#define BATCH_CHUNK 8U
+
+BUILD_ASSERT(NUM_LEDS >= BATCH_CHUNK, "bad handle must be past a chunk");
+
+ZTEST_DMEM static const struct device *leds[] = {
+	DT_FOREACH_STATUS_OKAY(blink_gpio_led, BLINK_DEV)
+};
+
+ZTEST_BMEM static unsigned int periods[NUM_LEDS];
+
+/* All the LEDs, then a device of another class */
+ZTEST_BMEM static const struct device *bad_leds[NUM_LEDS + 1U];
+ZTEST_BMEM static unsigned int bad_periods[NUM_LEDS + 1U];
+ZTEST_BMEM static bool bad_returned;
+
+static K_THREAD_STACK_DEFINE(bad_stack, 1024);
+static struct k_thread bad_thread;
+
+ZTEST_USER(blink_userspace, test_set_period_ms)
+{
+	for (size_t i = 0; i < NUM_LEDS; i++) {
+		zassert_ok(blink_set_period_ms(leds[i], PERIOD_MS));
+		zassert_ok(blink_off(leds[i]));
+	}
+}
+
+ZTEST_USER(blink_userspace, test_set_period_ms_many)
+{
+	for (size_t i = 0; i < NUM_LEDS; i++) {
+		periods[i] = PERIOD_MS;
+	}
+
+	zassert_ok(blink_set_period_ms_many(leds, periods, NUM_LEDS));
+	zassert_ok(blink_set_period_ms_many(leds, periods, 0));
+}
+
+ZTEST_USER(blink_userspace, test_set_period_ms_many_bad_array)
+{
+	ztest_set_fault_valid(true);
+	(void)blink_set_period_ms_many((const struct device **)0x1, periods,
+				       NUM_LEDS);
+	zassert_unreachable("bad array was accepted");
+}
+
+static uint32_t period_changes(const struct device *dev)
+{
+	struct stats_hdr *hdr = stats_group_find(dev->name);
+
+	zassert_not_null(hdr, "no group for %s", dev->name);
+
+	return CONTAINER_OF(hdr, STATS_SECT_DECL(blink_gpio_led_counters),
+			    s_hdr)->period_changes;
+}
+
+static void bad_batch_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	ztest_set_fault_valid(true);
+	(void)blink_set_period_ms_many(bad_leds, bad_periods,
+				       ARRAY_SIZE(bad_leds));
+	bad_returned = true;
+}
+
+ZTEST(blink_userspace, test_set_period_ms_many_bad_device)
+{
+	uint32_t changes[NUM_LEDS];
+
+	for (size_t i = 0; i < NUM_LEDS; i++) {
+		bad_leds[i] = leds[i];
+		bad_periods[i] = PERIOD_MS;
+		changes[i] = period_changes(leds[i]);
+	}
+	bad_leds[NUM_LEDS] = DEVICE_DT_GET(DT_NODELABEL(gpio_emul));
+	bad_periods[NUM_LEDS] = PERIOD_MS;
+	bad_returned = false;
+
+	k_thread_create(&bad_thread, bad_stack,
+			K_THREAD_STACK_SIZEOF(bad_stack), bad_batch_thread,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0),
+			K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	zassert_ok(k_thread_join(&bad_thread, K_FOREVER));
+
+	zassert_false(bad_returned, "bad device was accepted");
+
+	/* Rejected before the first chunk was applied */
+	for (size_t i = 0; i < NUM_LEDS; i++) {
+		zassert_equal(period_changes(leds[i]), changes[i], "LED %zu",
+			      i);
+	}
+}
+
+ZTEST_USER(blink_userspace, test_benchmark)
+{
+	uint32_t start, single, many;
+
+	for (size_t i = 0; i < NUM_LEDS; i++) {
+		periods[i] = PERIOD_MS;
+	}
+
+	start = k_cycle_get_32();
+	for (uint32_t n = 0; n < NUM_ITERATIONS; n++) {
+		for (size_t i = 0; i < NUM_LEDS; i++) {
+			(void)blink_set_period_ms(leds[i], periods[i]);
+		}
+	}
+	single = (k_cycle_get_32() - start) / (NUM_ITERATIONS * NUM_LEDS);
+
+	start = k_cycle_get_32();
+	for (uint32_t n = 0; n < NUM_ITERATIONS; n++) {
+		(void)blink_set_period_ms_many(leds, periods, NUM_LEDS);
+	}
+	many = (k_cycle_get_32() - start) / (NUM_ITERATIONS * NUM_LEDS);
+
+	/* Wall-clock figures, not asserted as they depend on the host */
+	TC_PRINT("%u LEDs, cycles per LED: single %u, batched %u\n", NUM_LEDS,
+		 single, many);
+}
+
+static void *blink_userspace_setup(void)
+{
+	for (size_t i = 0; i < NUM_LEDS; i++) {
+		zassert_true(device_is_ready(leds[i]), "LED %zu not ready", i);
+		k_object_access_all_grant(leds[i]);
+	}
+	k_object_access_all_grant(DEVICE_DT_GET(DT_NODELABEL(gpio_emul)));
+
+	return NULL;
+}
+
+static void blink_userspace_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (size_t i = 0; i < NUM_LEDS; i++) {
+		(void)blink_off(leds[i]);
+	}
+}
+
+ZTEST_SUITE(blink_userspace, NULL, blink_userspace_setup, NULL,
+	    blink_userspace_after, NULL);
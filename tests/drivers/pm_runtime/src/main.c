@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test device runtime power management of the drivers
+ *
+ * This suite checks that the example sensor is only resumed for fetches,
+ * asynchronous reads and while a trigger is set, and the blink LED while it
+ * blinks, with their pins released when suspended. It also reports the share
+ * of time the sensor spends active in each acquisition mode.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#include <app/drivers/blink.h>
+#include <app/lib/device_residency.h>
+
+#define SENSOR_NODE DT_NODELABEL(example_sensor)
+#define LED_NODE    DT_NODELABEL(blink_led)
+
+#define NUM_SAMPLES      20U
+#define SAMPLE_PERIOD_MS 10U
+#define ACQUISITION_MS   (NUM_SAMPLES * SAMPLE_PERIOD_MS)
+
+static const struct device *const sensor = DEVICE_DT_GET(SENSOR_NODE);
+static const struct gpio_dt_spec input =
+	GPIO_DT_SPEC_GET(SENSOR_NODE, input_gpios);
+static const struct device *const led = DEVICE_DT_GET(LED_NODE);
+static const struct gpio_dt_spec led_gpio =
+	GPIO_DT_SPEC_GET(LED_NODE, led_gpios);
+
+SENSOR_DT_READ_IODEV(prox_iodev, SENSOR_NODE, {SENSOR_CHAN_PROX, 0});
+RTIO_DEFINE_WITH_MEMPOOL(prox_ctx, 1, 1, 1, 16, sizeof(void *));
+
+static const struct sensor_trigger trig = {
+	.type = SENSOR_TRIG_NEAR_FAR,
+	.chan = SENSOR_CHAN_PROX,
+};
+
+static atomic_t trigger_count;
+
+static void trigger_handler(const struct device *dev,
+			    const struct sensor_trigger *trigger)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(trigger);
+
+	atomic_inc(&trigger_count);
+}
+
+static void assert_state(const struct device *dev,
+			 enum pm_device_state expected)
+{
+	enum pm_device_state state;
+
+	zassert_ok(pm_device_state_get(dev, &state));
+	zassert_equal(state, expected, "%s is %s", dev->name,
+		      pm_device_state_str(state));
+}
+
+static void assert_released(const struct gpio_dt_spec *spec)
+{
+	gpio_flags_t flags;
+
+	zassert_ok(gpio_emul_flags_get(spec->port, spec->pin, &flags));
+	zassert_equal(flags & (GPIO_INPUT | GPIO_OUTPUT), 0,
+		      "pin %u still configured", spec->pin);
+}
+
+/* Residency accumulated since @p start */
+static void residency_since(const struct device *dev,
+			    const struct device_residency_stats *start,
+			    struct device_residency_stats *delta)
+{
+	zassert_ok(device_residency_get(dev, delta));
+
+	delta->active_us -= start->active_us;
+	delta->suspended_us -= start->suspended_us;
+	delta->resumes -= start->resumes;
+}
+
+static void report(const char *mode, const struct device_residency_stats *res)
+{
+	uint64_t total_us = res->active_us + res->suspended_us;
+
+	TC_PRINT("%s: active %u us of %u us (%u.%02u %%), %u resumes\n", mode,
+		 (unsigned int)res->active_us, (unsigned int)total_us,
+		 (unsigned int)(res->active_us * 100U / total_us),
+		 (unsigned int)(res->active_us * 10000U / total_us % 100U),
+		 res->resumes);
+}
+
+ZTEST(pm_runtime, test_sensor_idle)
+{
+	assert_state(sensor, PM_DEVICE_STATE_SUSPENDED);
+	assert_released(&input);
+}
+
+ZTEST(pm_runtime, test_sensor_poll)
+{
+	struct device_residency_stats start, res;
+	struct sensor_value val;
+
+	zassert_ok(device_residency_get(sensor, &start));
+
+	for (unsigned int i = 0U; i < NUM_SAMPLES; i++) {
+		zassert_ok(sensor_sample_fetch(sensor));
+		zassert_ok(sensor_channel_get(sensor, SENSOR_CHAN_PROX, &val));
+		assert_state(sensor, PM_DEVICE_STATE_SUSPENDED);
+		k_msleep(SAMPLE_PERIOD_MS);
+	}
+
+	residency_since(sensor, &start, &res);
+	report("poll", &res);
+
+	zassert_equal(res.resumes, NUM_SAMPLES);
+	zassert_true(res.active_us < res.suspended_us);
+}
+
+ZTEST(pm_runtime, test_sensor_async)
+{
+	struct device_residency_stats start, res;
+	struct rtio_cqe *cqe;
+	uint32_t buf_len;
+	uint8_t *buf;
+
+	zassert_ok(device_residency_get(sensor, &start));
+
+	for (unsigned int i = 0U; i < NUM_SAMPLES; i++) {
+		zassert_ok(sensor_read_async_mempool(&prox_iodev, &prox_ctx,
+						     NULL));
+		cqe = rtio_cqe_consume_block(&prox_ctx);
+		zassert_ok(cqe->result);
+		zassert_ok(rtio_cqe_get_mempool_buffer(&prox_ctx, cqe, &buf,
+						       &buf_len));
+		rtio_cqe_release(&prox_ctx, cqe);
+		rtio_release_buffer(&prox_ctx, buf, buf_len);
+
+		assert_state(sensor, PM_DEVICE_STATE_SUSPENDED);
+		k_msleep(SAMPLE_PERIOD_MS);
+	}
+
+	residency_since(sensor, &start, &res);
+	report("async", &res);
+
+	zassert_equal(res.resumes, NUM_SAMPLES);
+	zassert_true(res.active_us < res.suspended_us);
+}
+
+ZTEST(pm_runtime, test_sensor_trigger)
+{
+	struct device_residency_stats start, res;
+
+	zassert_ok(device_residency_get(sensor, &start));
+
+	zassert_ok(sensor_trigger_set(sensor, &trig, trigger_handler));
+	assert_state(sensor, PM_DEVICE_STATE_ACTIVE);
+
+	/* Setting the handler again keeps a single reference */
+	zassert_ok(sensor_trigger_set(sensor, &trig, trigger_handler));
+
+	atomic_clear(&trigger_count);
+	for (unsigned int i = 0U; i < NUM_SAMPLES; i++) {
+		zassert_ok(gpio_emul_input_set(input.port, input.pin, i & 1U));
+		k_msleep(SAMPLE_PERIOD_MS);
+	}
+	zassert_true(atomic_get(&trigger_count) > 0);
+
+	zassert_ok(sensor_trigger_set(sensor, &trig, NULL));
+	assert_state(sensor, PM_DEVICE_STATE_SUSPENDED);
+	assert_released(&input);
+
+	residency_since(sensor, &start, &res);
+	report("trigger", &res);
+
+	zassert_equal(res.resumes, 1U);
+	zassert_true(res.active_us >= (ACQUISITION_MS - SAMPLE_PERIOD_MS) *
+					      USEC_PER_MSEC);
+}
+
+ZTEST(pm_runtime, test_blink)
+{
+	struct device_residency_stats start, res;
+
+	assert_state(led, PM_DEVICE_STATE_SUSPENDED);
+	assert_released(&led_gpio);
+
+	zassert_ok(device_residency_get(led, &start));
+
+	zassert_ok(blink_set_period_ms(led, SAMPLE_PERIOD_MS));
+	assert_state(led, PM_DEVICE_STATE_ACTIVE);
+
+	/* Period changes while blinking keep the LED resumed */
+	zassert_ok(blink_set_period_ms(led, 2U * SAMPLE_PERIOD_MS));
+	k_msleep(ACQUISITION_MS);
+
+	zassert_ok(blink_off(led));
+	assert_state(led, PM_DEVICE_STATE_SUSPENDED);
+	assert_released(&led_gpio);
+
+	/* Already off */
+	zassert_ok(blink_off(led));
+
+	residency_since(led, &start, &res);
+	report("blink", &res);
+
+	zassert_equal(res.resumes, 1U);
+	zassert_true(res.active_us >= ACQUISITION_MS * USEC_PER_MSEC);
+}
+
+ZTEST(pm_runtime, test_unregistered)
+{
+	struct device_residency_stats res;
+
+	zassert_equal(device_residency_get(input.port, &res), -ENOENT);
+}
+
+static void *pm_runtime_setup(void)
+{
+	zassert_true(device_is_ready(sensor));
+	zassert_true(device_is_ready(led));
+
+	return NULL;
+}
+
+ZTEST_SUITE(pm_runtime, NULL, pm_runtime_setup, NULL, NULL, NULL);
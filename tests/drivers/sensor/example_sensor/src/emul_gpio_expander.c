@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT vnd_emul_gpio_expander
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_utils.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/kernel.h>
+
+#include "emul_gpio_expander.h"
+
+/* After the I2C controller, before the example sensor */
+#define EMUL_GPIO_EXPANDER_INIT_PRIORITY 70
+
+/* GPIO driver */
+
+struct emul_gpio_expander_data {
+	struct gpio_driver_data common;
+};
+
+struct emul_gpio_expander_config {
+	struct gpio_driver_config common;
+	struct i2c_dt_spec i2c;
+};
+
+static int emul_gpio_expander_pin_configure(const struct device *dev,
+					    gpio_pin_t pin, gpio_flags_t flags)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pin);
+
+	if ((flags & GPIO_OUTPUT) != 0U) {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+static int emul_gpio_expander_port_get_raw(const struct device *dev,
+					   gpio_port_value_t *value)
+{
+	const struct emul_gpio_expander_config *config = dev->config;
+	uint8_t input;
+	int ret;
+
+	ret = i2c_reg_read_byte_dt(&config->i2c, EMUL_GPIO_EXPANDER_REG_INPUT,
+				   &input);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*value = input;
+
+	return 0;
+}
+
+static int emul_gpio_expander_port_set_masked_raw(const struct device *dev,
+						  gpio_port_pins_t mask,
+						  gpio_port_value_t value)
+{
+	return -ENOTSUP;
+}
+
+static int emul_gpio_expander_port_set_bits_raw(const struct device *dev,
+						gpio_port_pins_t pins)
+{
+	return -ENOTSUP;
+}
+
+static int emul_gpio_expander_port_clear_bits_raw(const struct device *dev,
+						  gpio_port_pins_t pins)
+{
+	return -ENOTSUP;
+}
+
+static int emul_gpio_expander_port_toggle_bits(const struct device *dev,
+					       gpio_port_pins_t pins)
+{
+	return -ENOTSUP;
+}
+
+static DEVICE_API(gpio, emul_gpio_expander_api) = {
+	.pin_configure = &emul_gpio_expander_pin_configure,
+	.port_get_raw = &emul_gpio_expander_port_get_raw,
+	.port_set_masked_raw = &emul_gpio_expander_port_set_masked_raw,
+	.port_set_bits_raw = &emul_gpio_expander_port_set_bits_raw,
+	.port_clear_bits_raw = &emul_gpio_expander_port_clear_bits_raw,
+	.port_toggle_bits = &emul_gpio_expander_port_toggle_bits,
+};
+
+static int emul_gpio_expander_init(const struct device *dev)
+{
+	const struct emul_gpio_expander_config *config = dev->config;
+
+	if (!i2c_is_ready_dt(&config->i2c)) {
+		return -ENODEV;
+	}
+
+	return 0;
+}
+
+/* I2C bus emulator */
+
+struct emul_gpio_expander_emul_data {
+	uint8_t input;
+};
+
+static int emul_gpio_expander_transfer(const struct emul *target,
+				       struct i2c_msg *msgs, int num_msgs,
+				       int addr)
+{
+	struct emul_gpio_expander_emul_data *data = target->data;
+
+	ARG_UNUSED(addr);
+
+	if ((num_msgs != 2) || ((msgs[0].flags & I2C_MSG_READ) != 0U) ||
+	    ((msgs[1].flags & I2C_MSG_READ) == 0U) || (msgs[0].len != 1U) ||
+	    (msgs[1].len != 1U)) {
+		return -EIO;
+	}
+
+	if (msgs[0].buf[0] != EMUL_GPIO_EXPANDER_REG_INPUT) {
+		return -EIO;
+	}
+
+	/* Model the time the transaction would hold the bus */
+	k_busy_wait(EMUL_GPIO_EXPANDER_TRANSFER_US);
+
+	msgs[1].buf[0] = data->input;
+
+	return 0;
+}
+
+static const struct i2c_emul_api emul_gpio_expander_bus_api = {
+	.transfer = &emul_gpio_expander_transfer,
+};
+
+static int emul_gpio_expander_emul_init(const struct emul *target,
+					const struct device *parent)
+{
+	ARG_UNUSED(target);
+	ARG_UNUSED(parent);
+
+	return 0;
+}
+
+void emul_gpio_expander_set_input(const struct emul *target, uint8_t input)
+{
+	struct emul_gpio_expander_emul_data *data = target->data;
+
+	data->input = input;
+}
+
+#define EMUL_GPIO_EXPANDER_DEFINE(inst)                                        \
+	static struct emul_gpio_expander_data data##inst;                      \
+                                                                               \
+	static const struct emul_gpio_expander_config config##inst = {         \
+	    .common = {                                                        \
+		.port_pin_mask = GPIO_PORT_PIN_MASK_FROM_DT_INST(inst),        \
+	    },                                                                 \
+	    .i2c = I2C_DT_SPEC_INST_GET(inst),                                 \
+	};                                                                     \
+                                                                               \
+	DEVICE_DT_INST_DEFINE(inst, emul_gpio_expander_init, NULL,             \
+			      &data##inst, &config##inst, POST_KERNEL,         \
+			      EMUL_GPIO_EXPANDER_INIT_PRIORITY,                \
+			      &emul_gpio_expander_api);                        \
+                                                                               \
+	static struct emul_gpio_expander_emul_data emul_data##inst;            \
+                                                                               \
+	EMUL_DT_INST_DEFINE(inst, emul_gpio_expander_emul_init,                \
+			    &emul_data##inst, NULL,                            \
+			    &emul_gpio_expander_bus_api, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(EMUL_GPIO_EXPANDER_DEFINE)
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EMUL_GPIO_EXPANDER_H_
+#define EMUL_GPIO_EXPANDER_H_
+
+#include <stdint.h>
+
+#include <zephyr/drivers/emul.h>
+
+/** Input port register address. */
+#define EMUL_GPIO_EXPANDER_REG_INPUT 0x00U
+
+/**
+ * Time spent on the bus by a register read: address and register bytes,
+ * repeated start, address and data bytes at 100 kHz.
+ */
+#define EMUL_GPIO_EXPANDER_TRANSFER_US 400U
+
+/**
+ * @brief Set the level of the expander input pins.
+ *
+ * @param target Expander emulator instance.
+ * @param input Input port value, one bit per pin.
+ */
+void emul_gpio_expander_set_input(const struct emul *target, uint8_t input);
+
+#endif /* EMUL_GPIO_EXPANDER_H_ */
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test example_sensor driver
+ *
+ * This suite verifies the example_sensor driver with its input connected
+ * through an emulated I2C GPIO expander. It compares how long the caller is
+ * blocked by a synchronous fetch against an asynchronous (RTIO) read.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#include "emul_gpio_expander.h"
+
+#define SENSOR_NODE   DT_NODELABEL(example_sensor)
+#define EXPANDER_NODE DT_NODELABEL(gpio_expander)
+
+SENSOR_DT_READ_IODEV(prox_iodev, SENSOR_NODE, {SENSOR_CHAN_PROX, 0});
+RTIO_DEFINE_WITH_MEMPOOL(prox_ctx, 1, 1, 1, 16, sizeof(void *));
+
+static const struct device *const sensor = DEVICE_DT_GET(SENSOR_NODE);
+static const struct emul *const expander = EMUL_DT_GET(EXPANDER_NODE);
+
+static uint32_t elapsed_us(uint32_t start)
+{
+	return k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+}
+
+ZTEST(example_sensor, test_fetch)
+{
+	struct sensor_value val;
+	uint32_t start, blocked;
+
+	emul_gpio_expander_set_input(expander, BIT(0));
+
+	start = k_cycle_get_32();
+	zassert_ok(sensor_sample_fetch(sensor));
+	blocked = elapsed_us(start);
+
+	zassert_ok(sensor_channel_get(sensor, SENSOR_CHAN_PROX, &val));
+	zassert_equal(val.val1, 1, "unexpected proximity state");
+
+	TC_PRINT("sync fetch: caller blocked %u us\n", blocked);
+
+	zassert_true(blocked >= EMUL_GPIO_EXPANDER_TRANSFER_US,
+		     "fetch did not wait for the bus transaction");
+}
+
+ZTEST(example_sensor, test_read_async)
+{
+	const struct sensor_chan_spec prox_chan = {SENSOR_CHAN_PROX, 0};
+	const struct sensor_decoder_api *decoder;
+	struct sensor_byte_data data;
+	struct rtio_cqe *cqe;
+	uint32_t start, blocked, latency, buf_len, fit = 0U;
+	uint8_t *buf;
+	int ret;
+
+	emul_gpio_expander_set_input(expander, 0U);
+
+	start = k_cycle_get_32();
+	zassert_ok(sensor_read_async_mempool(&prox_iodev, &prox_ctx, NULL));
+	blocked = elapsed_us(start);
+
+	cqe = rtio_cqe_consume_block(&prox_ctx);
+	latency = elapsed_us(start);
+
+	ret = cqe->result;
+	zassert_ok(ret, "read failed (%d)", ret);
+	zassert_ok(rtio_cqe_get_mempool_buffer(&prox_ctx, cqe, &buf, &buf_len));
+	rtio_cqe_release(&prox_ctx, cqe);
+
+	zassert_ok(sensor_get_decoder(sensor, &decoder));
+	zassert_equal(decoder->decode(buf, prox_chan, &fit, 1, &data), 1);
+	zassert_equal(data.readings[0].is_near, 0, "unexpected proximity state");
+
+	rtio_release_buffer(&prox_ctx, buf, buf_len);
+
+	TC_PRINT("async read: caller blocked %u us, fetch latency %u us\n",
+		 blocked, latency);
+
+	zassert_true(blocked < EMUL_GPIO_EXPANDER_TRANSFER_US,
+		     "submitting thread waited for the bus transaction");
+	zassert_true(latency >= EMUL_GPIO_EXPANDER_TRANSFER_US,
+		     "read completed before the bus transaction");
+}
+
+static void *example_sensor_setup(void)
+{
+	zassert_true(device_is_ready(sensor), "sensor not ready");
+
+	return NULL;
+}
+
+ZTEST_SUITE(example_sensor, NULL, example_sensor_setup, NULL, NULL, NULL);
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test example_sensor analog variant
+ *
+ * This suite drives the emulated ADC input across the threshold and inside
+ * the hysteresis band, checks the proximity level and raw distance, and
+ * measures the number of samples per second processed by the driver.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/adc.h>
+#include <zephyr/drivers/adc/adc_emul.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/ztest.h>
+
+#define SENSOR_NODE DT_NODELABEL(example_sensor_adc)
+
+/* 12 bits over the 3300 mV internal reference: 2048 is 1650 mV */
+#define NEAR_MV 1000U
+#define BAND_MV 1750U
+#define FAR_MV  2500U
+
+/* Long enough for two blocks, whatever the block size */
+#define SETTLE_MS                                                              \
+	(2U * CONFIG_EXAMPLE_SENSOR_ADC_BLOCK_SIZE *                           \
+		 DT_PROP(SENSOR_NODE, sample_interval_us) / 1000U +            \
+	 20U)
+
+#define RUN_MS 1000U
+
+static const struct device *const sensor = DEVICE_DT_GET(SENSOR_NODE);
+static const struct adc_dt_spec channel = ADC_DT_SPEC_GET(SENSOR_NODE);
+
+static void input_set(uint32_t mv)
+{
+	zassert_ok(adc_emul_const_value_set(channel.dev, channel.channel_id,
+					    mv));
+	k_msleep(SETTLE_MS);
+}
+
+static int32_t channel_get(enum sensor_channel chan)
+{
+	struct sensor_value val;
+
+	zassert_ok(sensor_sample_fetch(sensor));
+	zassert_ok(sensor_channel_get(sensor, chan, &val));
+
+	return val.val1;
+}
+
+ZTEST(example_sensor_adc, test_threshold)
+{
+	input_set(FAR_MV);
+	zassert_equal(channel_get(SENSOR_CHAN_PROX), 0);
+
+	input_set(NEAR_MV);
+	zassert_equal(channel_get(SENSOR_CHAN_PROX), 1);
+
+	input_set(FAR_MV);
+	zassert_equal(channel_get(SENSOR_CHAN_PROX), 0);
+}
+
+ZTEST(example_sensor_adc, test_hysteresis)
+{
+	/* Inside the band, the level does not change */
+	input_set(FAR_MV);
+	input_set(BAND_MV);
+	zassert_equal(channel_get(SENSOR_CHAN_PROX), 0);
+
+	input_set(NEAR_MV);
+	input_set(BAND_MV);
+	zassert_equal(channel_get(SENSOR_CHAN_PROX), 1);
+}
+
+ZTEST(example_sensor_adc, test_distance)
+{
+	int32_t raw;
+
+	input_set(NEAR_MV);
+
+	raw = channel_get(SENSOR_CHAN_DISTANCE);
+	zassert_within(raw, (NEAR_MV << 12) / 3300U, 2, "raw %d", raw);
+
+	zassert_equal(sensor_channel_get(sensor, SENSOR_CHAN_AMBIENT_TEMP,
+					 &(struct sensor_value){0}),
+		      -ENOTSUP);
+}
+
+static atomic_t samples;
+
+static int count_samples(const struct device *dev, unsigned int chan,
+			 void *data, uint32_t *result)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(chan);
+	ARG_UNUSED(data);
+
+	atomic_inc(&samples);
+	*result = FAR_MV;
+
+	return 0;
+}
+
+ZTEST(example_sensor_adc, test_throughput)
+{
+	uint32_t expected = USEC_PER_SEC / DT_PROP(SENSOR_NODE,
+						   sample_interval_us);
+	uint32_t rate;
+
+	zassert_ok(adc_emul_value_func_set(channel.dev, channel.channel_id,
+					   count_samples, NULL));
+
+	atomic_clear(&samples);
+	k_msleep(RUN_MS);
+	rate = (uint32_t)atomic_get(&samples) * 1000U / RUN_MS;
+
+	TC_PRINT("%u samples/s (%u expected), %u samples per block\n", rate,
+		 expected, CONFIG_EXAMPLE_SENSOR_ADC_BLOCK_SIZE);
+
+	/* Sampling goes on back to back across blocks */
+	zassert_true(rate >= expected * 9U / 10U, "%u samples/s", rate);
+	zassert_equal(channel_get(SENSOR_CHAN_PROX), 0);
+}
+
+static void *example_sensor_adc_setup(void)
+{
+	zassert_true(device_is_ready(sensor));
+
+	return NULL;
+}
+
+ZTEST_SUITE(example_sensor_adc, NULL, example_sensor_adc_setup, NULL, NULL,
+	    NULL);
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test example_sensor performance counters
+ *
+ * This suite fetches samples and drives the emulated input, then checks the
+ * counters of the sensor stats group, both directly and through the 'stat'
+ * shell command.
+ */
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+#include <zephyr/stats/stats.h>
+#include <zephyr/ztest.h>
+
+#include <app/drivers/sensor/example_sensor.h>
+
+#define SENSOR_NODE DT_NODELABEL(example_sensor)
+
+static const struct device *const sensor = DEVICE_DT_GET(SENSOR_NODE);
+static const struct gpio_dt_spec input =
+	GPIO_DT_SPEC_GET(SENSOR_NODE, input_gpios);
+
+static STATS_SECT_DECL(example_sensor_counters) *counters;
+
+ZTEST(example_sensor_counters, test_fetches)
+{
+	uint32_t fetches = counters->fetches;
+
+	for (int i = 0; i < 5; i++) {
+		zassert_ok(sensor_sample_fetch(sensor));
+	}
+
+	zassert_equal(counters->fetches, fetches + 5U);
+	zassert_equal(counters->fetch_errors, 0U);
+}
+
+ZTEST(example_sensor_counters, test_edges)
+{
+	uint32_t edges = counters->edges;
+
+	for (int i = 0; i < 4; i++) {
+		zassert_ok(gpio_emul_input_set(input.port, input.pin,
+					       (i & 1) ? 0 : 1));
+		k_msleep(1);
+	}
+
+	zassert_equal(counters->edges, edges + 4U);
+	zassert_equal(counters->edges_dropped, 0U);
+}
+
+ZTEST(example_sensor_counters, test_shell)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+	const char *output;
+	size_t len;
+
+	zassert_ok(sensor_sample_fetch(sensor));
+
+	shell_backend_dummy_clear_output(sh);
+	zassert_ok(shell_execute_cmd(sh, "stat list"));
+	output = shell_backend_dummy_get_output(sh, &len);
+	zassert_not_null(strstr(output, sensor->name), "%s", output);
+
+	shell_backend_dummy_clear_output(sh);
+	zassert_ok(shell_execute_cmd(sh, "stat show example-sensor"));
+	output = shell_backend_dummy_get_output(sh, &len);
+	zassert_not_null(strstr(output, "fetches: "), "%s", output);
+	zassert_not_null(strstr(output, "edges_dropped: 0"), "%s", output);
+
+	zassert_not_ok(shell_execute_cmd(sh, "stat show no-such-group"));
+}
+
+static void *example_sensor_counters_setup(void)
+{
+	struct stats_hdr *hdr;
+
+	zassert_true(device_is_ready(sensor));
+
+	hdr = stats_group_find(sensor->name);
+	zassert_not_null(hdr, "no group for %s", sensor->name);
+	counters = CONTAINER_OF(hdr, STATS_SECT_DECL(example_sensor_counters),
+				s_hdr);
+
+	/* Let the dummy shell backend finish initializing */
+	k_msleep(10);
+
+	return NULL;
+}
+
+ZTEST_SUITE(example_sensor_counters, NULL, example_sensor_counters_setup,
+	    NULL, NULL, NULL);
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test example_sensor input events
+ *
+ * This suite checks the key events reported by the example sensor through
+ * the input subsystem, the coalescing of rapid edges, and compares the time
+ * from an input edge to its input callback and to its sensor trigger
+ * handler.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/input/input.h>
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/ztest.h>
+
+#define SENSOR_NODE      DT_NODELABEL(example_sensor)
+#define FAST_SENSOR_NODE DT_NODELABEL(example_sensor_fast)
+
+#define COALESCE_MS DT_PROP(SENSOR_NODE, input_coalesce_ms)
+
+#define NUM_EDGES 100U
+
+#define MAX_EVENTS 8
+
+static const struct device *const sensor = DEVICE_DT_GET(SENSOR_NODE);
+static const struct device *const fast_sensor =
+	DEVICE_DT_GET(FAST_SENSOR_NODE);
+static const struct gpio_dt_spec input =
+	GPIO_DT_SPEC_GET(SENSOR_NODE, input_gpios);
+static const struct gpio_dt_spec fast_input =
+	GPIO_DT_SPEC_GET(FAST_SENSOR_NODE, input_gpios);
+
+static struct input_event events[MAX_EVENTS];
+static size_t num_events;
+
+static void sensor_input_cb(struct input_event *evt, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (num_events < ARRAY_SIZE(events)) {
+		events[num_events++] = *evt;
+	}
+}
+INPUT_CALLBACK_DEFINE(sensor, sensor_input_cb, NULL);
+
+static timing_t edge_time;
+static uint64_t input_cycles;
+static uint64_t trigger_cycles;
+static K_SEM_DEFINE(edge_sem, 0, 2);
+
+static void fast_input_cb(struct input_event *evt, void *user_data)
+{
+	timing_t now = timing_counter_get();
+
+	ARG_UNUSED(evt);
+	ARG_UNUSED(user_data);
+
+	input_cycles += timing_cycles_get(&edge_time, &now);
+	k_sem_give(&edge_sem);
+}
+INPUT_CALLBACK_DEFINE(fast_sensor, fast_input_cb, NULL);
+
+static void fast_trigger_handler(const struct device *dev,
+				 const struct sensor_trigger *trig)
+{
+	timing_t now = timing_counter_get();
+
+	ARG_UNUSED(dev);
+	ARG_UNUSED(trig);
+
+	trigger_cycles += timing_cycles_get(&edge_time, &now);
+	k_sem_give(&edge_sem);
+}
+
+static void input_set(const struct gpio_dt_spec *spec, int level)
+{
+	zassert_ok(gpio_emul_input_set(spec->port, spec->pin, level));
+}
+
+ZTEST(example_sensor_input, test_key_events)
+{
+	input_set(&input, 1);
+	k_msleep(COALESCE_MS + 10);
+	input_set(&input, 0);
+	k_msleep(COALESCE_MS + 10);
+
+	zassert_equal(num_events, 2U);
+	for (size_t i = 0U; i < num_events; i++) {
+		zassert_equal(events[i].type, INPUT_EV_KEY);
+		zassert_equal(events[i].code, INPUT_KEY_0);
+		zassert_true(events[i].sync);
+	}
+	zassert_equal(events[0].value, 1);
+	zassert_equal(events[1].value, 0);
+}
+
+ZTEST(example_sensor_input, test_coalesce)
+{
+	/* The first edge is reported, the next ones are merged */
+	input_set(&input, 1);
+	for (int i = 0; i < 5; i++) {
+		input_set(&input, 0);
+		input_set(&input, 1);
+	}
+	input_set(&input, 0);
+
+	zassert_true(num_events <= 1U, "%zu events", num_events);
+
+	k_msleep(COALESCE_MS + 10);
+
+	zassert_equal(num_events, 2U, "%zu events", num_events);
+	zassert_equal(events[0].value, 1);
+	zassert_equal(events[1].value, 0);
+
+	/* A bounce back to the reported level costs no event */
+	k_msleep(COALESCE_MS + 10);
+	num_events = 0U;
+	input_set(&input, 1);
+	input_set(&input, 0);
+	input_set(&input, 1);
+	k_msleep(COALESCE_MS + 10);
+
+	zassert_equal(num_events, 1U, "%zu events", num_events);
+	zassert_equal(events[0].value, 1);
+
+	input_set(&input, 0);
+	k_msleep(COALESCE_MS + 10);
+}
+
+ZTEST(example_sensor_input, test_overhead)
+{
+	static const struct sensor_trigger trig = {
+		.type = SENSOR_TRIG_NEAR_FAR,
+		.chan = SENSOR_CHAN_PROX,
+	};
+	uint64_t input_ns, trigger_ns;
+
+	zassert_ok(sensor_trigger_set(fast_sensor, &trig,
+				      fast_trigger_handler));
+
+	input_cycles = 0U;
+	trigger_cycles = 0U;
+
+	for (uint32_t i = 0U; i < NUM_EDGES; i++) {
+		edge_time = timing_counter_get();
+		input_set(&fast_input, (i + 1U) & 1U);
+
+		/* One input event and one trigger per edge */
+		zassert_ok(k_sem_take(&edge_sem, K_MSEC(100)));
+		zassert_ok(k_sem_take(&edge_sem, K_MSEC(100)));
+	}
+
+	zassert_ok(sensor_trigger_set(fast_sensor, &trig, NULL));
+
+	input_ns = timing_cycles_to_ns(input_cycles / NUM_EDGES);
+	trigger_ns = timing_cycles_to_ns(trigger_cycles / NUM_EDGES);
+
+	TC_PRINT("edge to handler: input %llu ns, trigger %llu ns\n",
+		 (unsigned long long)input_ns, (unsigned long long)trigger_ns);
+}
+
+static void *example_sensor_input_setup(void)
+{
+	zassert_true(device_is_ready(sensor));
+	zassert_true(device_is_ready(fast_sensor));
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void example_sensor_input_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Start outside of any coalescing window */
+	k_msleep(COALESCE_MS + 10);
+	num_events = 0U;
+}
+
+static void example_sensor_input_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(example_sensor_input, NULL, example_sensor_input_setup,
+	    example_sensor_input_before, NULL, example_sensor_input_teardown);
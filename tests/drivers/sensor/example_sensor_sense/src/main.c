@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test example_sensor port sense edge detection
+ *
+ * This suite runs on nrf52_bsim, with four sensors on pins of the same port
+ * detected with the SENSE mechanism. Input levels are driven through the
+ * BabbleSim GPIO test interface. It checks that no GPIOTE channel is taken by
+ * the inputs, and that edges, alone or on several inputs at once, trigger
+ * the instances that changed exactly once. The counters scenario checks the
+ * edge counters of each instance, and the runtime PM scenario that a level
+ * change while an instance is suspended is not reported once it resumes.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/stats/stats.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/ztest.h>
+
+#include <hal/nrf_gpio.h>
+#include <hal/nrf_gpiote.h>
+#include <NHW_GPIO.h>
+
+#include <app/drivers/sensor/example_sensor.h>
+
+#define SENSOR_SPEC(node) GPIO_DT_SPEC_GET(node, input_gpios)
+
+#define NUM_SENSORS 4
+
+/* Time for the interrupt and the trigger work item to run */
+#define SETTLE_MS 5
+
+static const struct device *const sensors[NUM_SENSORS] = {
+	DEVICE_DT_GET(DT_NODELABEL(sensor0)),
+	DEVICE_DT_GET(DT_NODELABEL(sensor1)),
+	DEVICE_DT_GET(DT_NODELABEL(sensor2)),
+	DEVICE_DT_GET(DT_NODELABEL(sensor3)),
+};
+
+static const struct gpio_dt_spec inputs[NUM_SENSORS] = {
+	SENSOR_SPEC(DT_NODELABEL(sensor0)),
+	SENSOR_SPEC(DT_NODELABEL(sensor1)),
+	SENSOR_SPEC(DT_NODELABEL(sensor2)),
+	SENSOR_SPEC(DT_NODELABEL(sensor3)),
+};
+
+static const struct sensor_trigger trig = {
+	.type = SENSOR_TRIG_NEAR_FAR,
+	.chan = SENSOR_CHAN_PROX,
+};
+
+/* Bit n set once sensor n triggered */
+static atomic_t triggered;
+/* Number of triggers of each sensor */
+static atomic_t trigger_count[NUM_SENSORS];
+
+static void trigger_handler(const struct device *dev,
+			    const struct sensor_trigger *trigger)
+{
+	ARG_UNUSED(trigger);
+
+	for (size_t i = 0U; i < NUM_SENSORS; i++) {
+		if (dev == sensors[i]) {
+			atomic_or(&triggered, BIT(i));
+			atomic_inc(&trigger_count[i]);
+		}
+	}
+}
+
+static void triggered_clear(void)
+{
+	atomic_clear(&triggered);
+	for (size_t i = 0U; i < NUM_SENSORS; i++) {
+		atomic_clear(&trigger_count[i]);
+	}
+}
+
+/* Physical level of the input of a sensor */
+static void input_drive(size_t i, bool level)
+{
+	nrf_gpio_test_change_pin_level(0U, inputs[i].pin, level);
+}
+
+/* Input level of a sensor when near or far */
+static bool input_level(size_t i, bool near)
+{
+	return near != ((inputs[i].dt_flags & GPIO_ACTIVE_LOW) != 0U);
+}
+
+static int level_get(size_t i)
+{
+	struct sensor_value val;
+
+	zassert_ok(sensor_sample_fetch(sensors[i]));
+	zassert_ok(sensor_channel_get(sensors[i], SENSOR_CHAN_PROX, &val));
+
+	return val.val1;
+}
+
+ZTEST(example_sensor_sense, test_no_gpiote_channels)
+{
+	for (size_t i = 0U; i < NUM_SENSORS; i++) {
+		zassert_not_equal(nrf_gpio_pin_sense_get(inputs[i].pin),
+				  NRF_GPIO_PIN_NOSENSE, "pin %u",
+				  inputs[i].pin);
+	}
+
+	for (uint32_t ch = 0U; ch < GPIOTE_CH_NUM; ch++) {
+		if (nrf_gpiote_mode_get(NRF_GPIOTE, ch) !=
+		    NRF_GPIOTE_MODE_EVENT) {
+			continue;
+		}
+
+		for (size_t i = 0U; i < NUM_SENSORS; i++) {
+			zassert_not_equal(nrf_gpiote_event_pin_get(NRF_GPIOTE,
+								   ch),
+					  inputs[i].pin,
+					  "GPIOTE channel %u on pin %u", ch,
+					  inputs[i].pin);
+		}
+	}
+}
+
+ZTEST(example_sensor_sense, test_single_edge)
+{
+	for (size_t i = 0U; i < NUM_SENSORS; i++) {
+		bool active_low = (inputs[i].dt_flags & GPIO_ACTIVE_LOW) != 0U;
+
+		triggered_clear();
+		input_drive(i, !active_low);
+		k_msleep(SETTLE_MS);
+
+		zassert_equal(atomic_get(&triggered), BIT(i),
+			      "sensor %u: triggered 0x%lx", i,
+			      atomic_get(&triggered));
+		zassert_equal(level_get(i), 1);
+
+		triggered_clear();
+		input_drive(i, active_low);
+		k_msleep(SETTLE_MS);
+
+		zassert_equal(atomic_get(&triggered), BIT(i));
+		zassert_equal(level_get(i), 0);
+	}
+}
+
+/* Sensors of the mask triggered exactly once, the others not at all */
+static void triggers_check(uint32_t mask)
+{
+	for (size_t i = 0U; i < NUM_SENSORS; i++) {
+		zassert_equal(atomic_get(&trigger_count[i]),
+			      ((mask & BIT(i)) != 0U) ? 1 : 0,
+			      "sensor %u: %ld triggers", i,
+			      atomic_get(&trigger_count[i]));
+	}
+}
+
+ZTEST(example_sensor_sense, test_simultaneous_edges)
+{
+	unsigned int key;
+
+	triggered_clear();
+
+	/* Sensors 1 and 3 change within the same interrupt */
+	key = irq_lock();
+	input_drive(1U, false);
+	input_drive(3U, true);
+	irq_unlock(key);
+	k_msleep(SETTLE_MS);
+
+	triggers_check(BIT(1) | BIT(3));
+	zassert_equal(level_get(1U), 1);
+	zassert_equal(level_get(3U), 1);
+
+	triggered_clear();
+
+	key = irq_lock();
+	input_drive(1U, true);
+	input_drive(3U, false);
+	irq_unlock(key);
+	k_msleep(SETTLE_MS);
+
+	triggers_check(BIT(1) | BIT(3));
+	zassert_equal(level_get(1U), 0);
+	zassert_equal(level_get(3U), 0);
+}
+
+#ifdef CONFIG_EXAMPLE_SENSOR_COUNTERS
+static STATS_SECT_DECL(example_sensor_counters) *counters_get(size_t i)
+{
+	struct stats_hdr *hdr = stats_group_find(sensors[i]->name);
+
+	zassert_not_null(hdr, "no group for %s", sensors[i]->name);
+
+	return CONTAINER_OF(hdr, STATS_SECT_DECL(example_sensor_counters),
+			    s_hdr);
+}
+
+ZTEST(example_sensor_sense, test_counters)
+{
+	uint32_t edges[NUM_SENSORS];
+	unsigned int key;
+
+	for (size_t i = 0U; i < NUM_SENSORS; i++) {
+		edges[i] = counters_get(i)->edges;
+	}
+
+	/* One edge each way on sensor 0, then on 1 and 3 at once */
+	input_drive(0U, input_level(0U, true));
+	k_msleep(SETTLE_MS);
+	input_drive(0U, input_level(0U, false));
+	k_msleep(SETTLE_MS);
+
+	key = irq_lock();
+	input_drive(1U, input_level(1U, true));
+	input_drive(3U, input_level(3U, true));
+	irq_unlock(key);
+	k_msleep(SETTLE_MS);
+
+	zassert_equal(counters_get(0U)->edges, edges[0] + 2U);
+	zassert_equal(counters_get(1U)->edges, edges[1] + 1U);
+	zassert_equal(counters_get(2U)->edges, edges[2]);
+	zassert_equal(counters_get(3U)->edges, edges[3] + 1U);
+
+	for (size_t i = 0U; i < NUM_SENSORS; i++) {
+		zassert_equal(counters_get(i)->edges_dropped, 0U, "sensor %u",
+			      i);
+	}
+}
+#endif /* CONFIG_EXAMPLE_SENSOR_COUNTERS */
+
+ZTEST(example_sensor_sense, test_resume)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_PM_DEVICE_RUNTIME);
+
+	/* Suspends sensor 0, which changes level meanwhile */
+	zassert_ok(sensor_trigger_set(sensors[0], &trig, NULL));
+	input_drive(0U, input_level(0U, true));
+	k_msleep(SETTLE_MS);
+
+	/* Resumed with the new level as reference */
+	zassert_ok(sensor_trigger_set(sensors[0], &trig, trigger_handler));
+	triggered_clear();
+
+	/* An edge on another pin of the port triggers that sensor only */
+	input_drive(2U, input_level(2U, true));
+	k_msleep(SETTLE_MS);
+
+	zassert_equal(atomic_get(&triggered), BIT(2), "triggered 0x%lx",
+		      atomic_get(&triggered));
+	zassert_equal(level_get(0U), 1);
+
+	/* Sensor 0 edges are seen again */
+	triggered_clear();
+	input_drive(0U, input_level(0U, false));
+	k_msleep(SETTLE_MS);
+
+	zassert_equal(atomic_get(&triggered), BIT(0));
+}
+
+static void example_sensor_sense_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* All far: pulled up for active low inputs, low otherwise */
+	for (size_t i = 0U; i < NUM_SENSORS; i++) {
+		input_drive(i, input_level(i, false));
+	}
+	k_msleep(SETTLE_MS);
+
+	triggered_clear();
+}
+
+static void *example_sensor_sense_setup(void)
+{
+	for (size_t i = 0U; i < NUM_SENSORS; i++) {
+		zassert_true(device_is_ready(sensors[i]));
+		zassert_ok(sensor_trigger_set(sensors[i], &trig,
+					      trigger_handler));
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(example_sensor_sense, NULL, example_sensor_sense_setup,
+	    example_sensor_sense_before, NULL, NULL);
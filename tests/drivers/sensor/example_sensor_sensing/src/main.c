@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test example_sensor sensing subsystem integration
+ *
+ * This suite opens 1, 2 and 4 sensing clients on the example proximity
+ * sensor, each with its own report interval, and measures the number of
+ * physical fetches per second. Fetches follow the shortest requested
+ * interval whatever the number of clients, where independent polling would
+ * cost the sum of all client rates.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sensing/sensing.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/ztest.h>
+
+#include <app/drivers/sensor/example_sensor.h>
+
+#define RUN_MS 1000U
+
+#define MAX_CLIENTS 4
+
+/* Requested intervals, the first one is the shortest */
+static const uint32_t client_interval_ms[MAX_CLIENTS] = {
+	50U, 100U, 200U, 400U,
+};
+
+static const struct device *const proximity =
+	DEVICE_DT_GET(DT_NODELABEL(example_proximity));
+static const struct gpio_dt_spec input =
+	GPIO_DT_SPEC_GET(DT_NODELABEL(example_sensor), input_gpios);
+
+static const struct sensing_sensor_info *info;
+
+struct client {
+	sensing_sensor_handle_t handle;
+	struct sensing_callback_list cb;
+	atomic_t reports;
+	uint32_t last_value;
+};
+
+static struct client clients[MAX_CLIENTS];
+
+static void on_data_event(sensing_sensor_handle_t handle, const void *buf,
+			  void *context)
+{
+	const struct sensing_sensor_value_uint32 *sample = buf;
+	struct client *client = context;
+
+	ARG_UNUSED(handle);
+
+	client->last_value = sample->readings[0].v;
+	atomic_inc(&client->reports);
+}
+
+static void clients_open(size_t n)
+{
+	for (size_t i = 0U; i < n; i++) {
+		struct sensing_sensor_config config = {
+			.attri = SENSING_SENSOR_ATTRIBUTE_INTERVAL,
+			.interval = client_interval_ms[i] * USEC_PER_MSEC,
+		};
+		struct client *client = &clients[i];
+
+		client->cb.on_data_event = on_data_event;
+		client->cb.context = client;
+		atomic_clear(&client->reports);
+
+		zassert_ok(sensing_open_sensor(info, &client->cb,
+					       &client->handle));
+		zassert_ok(sensing_set_config(client->handle, &config, 1));
+	}
+}
+
+static void clients_close(size_t n)
+{
+	for (size_t i = 0U; i < n; i++) {
+		zassert_ok(sensing_close_sensor(&clients[i].handle));
+	}
+}
+
+/* Physical fetches per second over RUN_MS */
+static uint32_t fetch_rate(void)
+{
+	uint32_t start = example_sensor_sensing_fetches(proximity);
+
+	k_msleep(RUN_MS);
+
+	return (example_sensor_sensing_fetches(proximity) - start) * 1000U /
+	       RUN_MS;
+}
+
+static void measure(size_t n)
+{
+	uint32_t polled = 0U;
+	uint32_t rate;
+
+	for (size_t i = 0U; i < n; i++) {
+		polled += 1000U / client_interval_ms[i];
+	}
+
+	clients_open(n);
+
+	/* Let the runtime apply the arbitrated interval */
+	k_msleep(client_interval_ms[n - 1U]);
+
+	rate = fetch_rate();
+
+	TC_PRINT("%zu clients: %u fetches/s (independent polling: %u/s)\n", n,
+		 rate, polled);
+	for (size_t i = 0U; i < n; i++) {
+		TC_PRINT("  client %zu: %u ms, %ld reports\n", i,
+			 client_interval_ms[i],
+			 (long)atomic_get(&clients[i].reports));
+	}
+
+	clients_close(n);
+
+	/* One fetch per shortest interval, shared by all clients */
+	zassert_within(rate, 1000U / client_interval_ms[0], 2U, "%u fetches/s",
+		       rate);
+	/* Samples are dispatched to the clients */
+	zassert_true(atomic_get(&clients[0].reports) > 0);
+}
+
+ZTEST(example_sensor_sensing, test_fetch_rate)
+{
+	measure(1U);
+	measure(2U);
+	measure(4U);
+}
+
+ZTEST(example_sensor_sensing, test_rearbitrate)
+{
+	uint32_t rate;
+
+	clients_open(MAX_CLIENTS);
+
+	/* The remaining clients set the pace */
+	zassert_ok(sensing_close_sensor(&clients[0].handle));
+	k_msleep(client_interval_ms[MAX_CLIENTS - 1U]);
+
+	rate = fetch_rate();
+
+	for (size_t i = 1U; i < MAX_CLIENTS; i++) {
+		zassert_ok(sensing_close_sensor(&clients[i].handle));
+	}
+
+	zassert_within(rate, 1000U / client_interval_ms[1], 2U, "%u fetches/s",
+		       rate);
+
+	/* No client left, no fetch */
+	k_msleep(client_interval_ms[MAX_CLIENTS - 1U]);
+	zassert_equal(fetch_rate(), 0U);
+}
+
+ZTEST(example_sensor_sensing, test_level)
+{
+	clients_open(1U);
+
+	zassert_ok(gpio_emul_input_set(input.port, input.pin, 1));
+	k_msleep(2U * client_interval_ms[0]);
+	zassert_equal(clients[0].last_value, 1U);
+
+	zassert_ok(gpio_emul_input_set(input.port, input.pin, 0));
+	k_msleep(2U * client_interval_ms[0]);
+	zassert_equal(clients[0].last_value, 0U);
+
+	clients_close(1U);
+}
+
+static void *example_sensor_sensing_setup(void)
+{
+	const struct sensing_sensor_info *infos;
+	int num;
+
+	zassert_true(device_is_ready(proximity));
+	zassert_ok(sensing_get_sensors(&num, &infos));
+
+	for (int i = 0; i < num; i++) {
+		if (infos[i].type == EXAMPLE_SENSOR_SENSING_TYPE_PROXIMITY) {
+			info = &infos[i];
+		}
+	}
+
+	zassert_not_null(info);
+
+	return NULL;
+}
+
+ZTEST_SUITE(example_sensor_sensing, NULL, example_sensor_sensing_setup, NULL,
+	    NULL, NULL);
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test example_sensor statistics channels
+ *
+ * This suite drives the emulated input with pulses of known width and checks
+ * the statistics reported through the private sensor channels.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <app/drivers/sensor/example_sensor.h>
+
+#define SENSOR_NODE DT_NODELABEL(example_sensor)
+
+/* Allowed error on time based channels, in microseconds */
+#define TOLERANCE_US 1000
+
+static const struct device *const sensor = DEVICE_DT_GET(SENSOR_NODE);
+static const struct gpio_dt_spec input =
+	GPIO_DT_SPEC_GET(SENSOR_NODE, input_gpios);
+
+static void pulse(int level, uint32_t ms)
+{
+	zassert_ok(gpio_emul_input_set(input.port, input.pin, level));
+	k_msleep(ms);
+}
+
+static int64_t channel_get_us(enum example_sensor_channel chan)
+{
+	struct sensor_value val;
+
+	zassert_ok(sensor_channel_get(sensor, (enum sensor_channel)chan, &val));
+
+	return sensor_value_to_micro(&val);
+}
+
+static void assert_within(int64_t value, int64_t expected)
+{
+	zassert_within(value, expected, TOLERANCE_US,
+		       "got %lld, expected %lld", value, expected);
+}
+
+ZTEST(example_sensor_stats, test_no_edges)
+{
+	struct sensor_value val;
+
+	k_msleep(5);
+
+	zassert_equal(sensor_channel_get(sensor,
+					 (enum sensor_channel)EXAMPLE_SENSOR_CHAN_LAST_EDGE,
+					 &val),
+		      -ENODATA);
+	zassert_equal(sensor_channel_get(sensor,
+					 (enum sensor_channel)EXAMPLE_SENSOR_CHAN_PULSE_MIN,
+					 &val),
+		      -ENODATA);
+	zassert_equal(channel_get_us(EXAMPLE_SENSOR_CHAN_EDGE_COUNT), 0);
+	zassert_equal(channel_get_us(EXAMPLE_SENSOR_CHAN_ACTIVE_TIME), 0);
+	assert_within(channel_get_us(EXAMPLE_SENSOR_CHAN_SINCE_LAST_EDGE),
+		      5000);
+}
+
+ZTEST(example_sensor_stats, test_pulses)
+{
+	pulse(1, 10);
+	pulse(0, 30);
+	pulse(1, 20);
+	pulse(0, 40);
+
+	zassert_equal(channel_get_us(EXAMPLE_SENSOR_CHAN_EDGE_COUNT),
+		      4 * 1000000);
+	assert_within(channel_get_us(EXAMPLE_SENSOR_CHAN_ACTIVE_TIME), 30000);
+	assert_within(channel_get_us(EXAMPLE_SENSOR_CHAN_PULSE_MIN), 10000);
+	assert_within(channel_get_us(EXAMPLE_SENSOR_CHAN_PULSE_MAX), 20000);
+	assert_within(channel_get_us(EXAMPLE_SENSOR_CHAN_SINCE_LAST_EDGE),
+		      40000);
+	/* 30 ms active out of 100 ms, in micro-percent */
+	zassert_within(channel_get_us(EXAMPLE_SENSOR_CHAN_DUTY_CYCLE),
+		       30 * 1000000, 1000000);
+}
+
+ZTEST(example_sensor_stats, test_ongoing_pulse)
+{
+	pulse(1, 25);
+
+	/* The pulse in progress counts as active time, but not as a pulse */
+	assert_within(channel_get_us(EXAMPLE_SENSOR_CHAN_ACTIVE_TIME), 25000);
+	zassert_equal(channel_get_us(EXAMPLE_SENSOR_CHAN_EDGE_COUNT),
+		      1 * 1000000);
+	zassert_within(channel_get_us(EXAMPLE_SENSOR_CHAN_DUTY_CYCLE),
+		       100 * 1000000, 1000000);
+
+	pulse(0, 0);
+}
+
+ZTEST(example_sensor_stats, test_fetch_no_double_count)
+{
+	pulse(1, 5);
+	zassert_ok(sensor_sample_fetch(sensor));
+	pulse(0, 5);
+	zassert_ok(sensor_sample_fetch(sensor));
+
+	zassert_equal(channel_get_us(EXAMPLE_SENSOR_CHAN_EDGE_COUNT),
+		      2 * 1000000);
+}
+
+static void *example_sensor_stats_setup(void)
+{
+	zassert_true(device_is_ready(sensor), "sensor not ready");
+
+	return NULL;
+}
+
+static void example_sensor_stats_before(void *fixture)
+{
+	struct sensor_value val = {0};
+
+	ARG_UNUSED(fixture);
+
+	zassert_ok(gpio_emul_input_set(input.port, input.pin, 0));
+	zassert_ok(sensor_attr_set(
+		sensor, SENSOR_CHAN_ALL,
+		(enum sensor_attribute)EXAMPLE_SENSOR_ATTR_STATS_RESET, &val));
+}
+
+ZTEST_SUITE(example_sensor_stats, NULL, example_sensor_stats_setup,
+	    example_sensor_stats_before, NULL, NULL);
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test example_sensor trigger response time
+ *
+ * This suite measures the time between an input edge, generated from a timer
+ * ISR, and the execution of the sensor trigger handler, while preemptible and
+ * cooperative threads keep the CPU busy.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/ztest.h>
+
+#define SENSOR_NODE DT_NODELABEL(example_sensor)
+
+/* Time a cooperative background thread keeps the CPU without yielding */
+#define LOAD_CHUNK_US  2000U
+#define EDGE_PERIOD_MS 7U
+#define NUM_EDGES      50U
+
+#define LOAD_STACK_SIZE 512
+
+static const struct device *const sensor = DEVICE_DT_GET(SENSOR_NODE);
+static const struct gpio_dt_spec input =
+	GPIO_DT_SPEC_GET(SENSOR_NODE, input_gpios);
+
+static const struct sensor_trigger trig = {
+	.type = SENSOR_TRIG_NEAR_FAR,
+	.chan = SENSOR_CHAN_PROX,
+};
+
+static volatile uint32_t edge_cycles;
+static uint32_t worst_cycles;
+static atomic_t edges;
+
+static void edge_timer_expire(struct k_timer *timer)
+{
+	static int level;
+
+	ARG_UNUSED(timer);
+
+	level = !level;
+	edge_cycles = k_cycle_get_32();
+	(void)gpio_emul_input_set(input.port, input.pin, level);
+}
+
+K_TIMER_DEFINE(edge_timer, edge_timer_expire, NULL);
+
+static void trigger_handler(const struct device *dev,
+			    const struct sensor_trigger *trigger)
+{
+	uint32_t response = k_cycle_get_32() - edge_cycles;
+
+	ARG_UNUSED(trigger);
+
+	worst_cycles = MAX(worst_cycles, response);
+	atomic_inc(&edges);
+
+	(void)sensor_sample_fetch(dev);
+}
+
+static void coop_load(void *p1, void *p2, void *p3)
+{
+	while (true) {
+		k_busy_wait(LOAD_CHUNK_US);
+		k_msleep(1);
+	}
+}
+
+static void preempt_load(void *p1, void *p2, void *p3)
+{
+	while (true) {
+		k_busy_wait(100U);
+	}
+}
+
+K_THREAD_DEFINE(coop_load_tid, LOAD_STACK_SIZE, coop_load, NULL, NULL, NULL,
+		K_PRIO_COOP(10), 0, SYS_FOREVER_MS);
+K_THREAD_DEFINE(preempt_load_tid, LOAD_STACK_SIZE, preempt_load, NULL, NULL,
+		NULL, K_PRIO_PREEMPT(5), 0, SYS_FOREVER_MS);
+
+ZTEST(example_sensor_trigger, test_response_time)
+{
+	uint32_t worst_us;
+
+	zassert_ok(sensor_trigger_set(sensor, &trig, trigger_handler));
+
+	k_thread_start(coop_load_tid);
+	k_thread_start(preempt_load_tid);
+	k_timer_start(&edge_timer, K_MSEC(EDGE_PERIOD_MS),
+		      K_MSEC(EDGE_PERIOD_MS));
+
+	while (atomic_get(&edges) < NUM_EDGES) {
+		k_msleep(EDGE_PERIOD_MS);
+	}
+
+	k_timer_stop(&edge_timer);
+	k_thread_abort(coop_load_tid);
+	k_thread_abort(preempt_load_tid);
+
+	zassert_ok(sensor_trigger_set(sensor, &trig, NULL));
+
+	worst_us = k_cyc_to_us_ceil32(worst_cycles);
+
+	TC_PRINT("worst-case response: %u us over %u edges\n", worst_us,
+		 (unsigned int)atomic_get(&edges));
+
+	if (IS_ENABLED(CONFIG_EXAMPLE_SENSOR_THREAD_META_IRQ)) {
+		zassert_true(worst_us < (LOAD_CHUNK_US / 2U),
+			     "handler waited for cooperative load");
+	} else {
+		zassert_true(worst_us < (2U * LOAD_CHUNK_US),
+			     "handler delayed by preemptible load");
+	}
+}
+
+static void *example_sensor_trigger_setup(void)
+{
+	zassert_true(device_is_ready(sensor), "sensor not ready");
+
+	return NULL;
+}
+
+ZTEST_SUITE(example_sensor_trigger, NULL, example_sensor_trigger_setup, NULL,
+	    NULL, NULL);
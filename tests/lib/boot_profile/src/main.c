@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test boot_profile library
+ *
+ * This suite verifies that the boot_profile library records the first mark
+ * of each boot phase only, and in order.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <app/lib/boot_profile.h>
+
+ZTEST(boot_profile, test_kernel_marked)
+{
+	uint32_t us;
+
+	zassert_ok(boot_profile_get_us(BOOT_PROFILE_KERNEL, &us));
+}
+
+ZTEST(boot_profile, test_first_mark_only)
+{
+	uint32_t kernel_us, first_us, us;
+
+	zassert_equal(boot_profile_get_us(BOOT_PROFILE_FIRST_SAMPLE, &us),
+		      -ENODATA);
+
+	boot_profile_mark(BOOT_PROFILE_FIRST_SAMPLE);
+	zassert_ok(boot_profile_get_us(BOOT_PROFILE_FIRST_SAMPLE, &first_us));
+
+	k_busy_wait(1000);
+
+	boot_profile_mark(BOOT_PROFILE_FIRST_SAMPLE);
+	zassert_ok(boot_profile_get_us(BOOT_PROFILE_FIRST_SAMPLE, &us));
+	zassert_equal(us, first_us, "phase marked twice");
+
+	zassert_ok(boot_profile_get_us(BOOT_PROFILE_KERNEL, &kernel_us));
+	zassert_true(kernel_us <= first_us, "phases out of order");
+}
+
+ZTEST_SUITE(boot_profile, NULL, NULL, NULL, NULL, NULL);
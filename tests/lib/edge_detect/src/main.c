@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test edge_detect library
+ *
+ * This suite verifies the edge masks computed by the edge_detect library,
+ * with and without majority filtering, over single and multi-word snapshots.
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+
+#include <app/lib/edge_detect.h>
+
+#define NUM_INPUTS 100U
+#define NUM_WORDS  EDGE_DETECT_WORDS(NUM_INPUTS)
+
+EDGE_DETECT_DEFINE(raw, NUM_INPUTS, 1, 1);
+EDGE_DETECT_DEFINE(majority, NUM_INPUTS, 3, 2);
+EDGE_DETECT_DEFINE(hysteresis, NUM_INPUTS, 5, 4);
+
+static edge_detect_word_t sample[NUM_WORDS];
+static edge_detect_word_t rising[NUM_WORDS];
+static edge_detect_word_t falling[NUM_WORDS];
+static edge_detect_word_t changed[NUM_WORDS];
+
+static void set_input(size_t input, int level)
+{
+	edge_detect_word_t bit = (edge_detect_word_t)1U
+				 << (input % EDGE_DETECT_WORD_BITS);
+
+	if (level != 0) {
+		sample[input / EDGE_DETECT_WORD_BITS] |= bit;
+	} else {
+		sample[input / EDGE_DETECT_WORD_BITS] &= ~bit;
+	}
+}
+
+static int get_input(const edge_detect_word_t *mask, size_t input)
+{
+	return (int)((mask[input / EDGE_DETECT_WORD_BITS] >>
+		      (input % EDGE_DETECT_WORD_BITS)) & 1U);
+}
+
+static bool update(struct edge_detect *ed)
+{
+	return edge_detect_update(ed, sample, rising, falling, changed);
+}
+
+ZTEST(edge_detect, test_raw_edges)
+{
+	/* Inputs spread over several words, including the last input */
+	static const size_t inputs[] = {0U, 33U, 70U, NUM_INPUTS - 1U};
+
+	zassert_false(update(&raw));
+
+	for (size_t i = 0U; i < ARRAY_SIZE(inputs); i++) {
+		set_input(inputs[i], 1);
+	}
+
+	zassert_true(update(&raw));
+
+	for (size_t n = 0U; n < NUM_INPUTS; n++) {
+		bool expected = false;
+
+		for (size_t i = 0U; i < ARRAY_SIZE(inputs); i++) {
+			expected = expected || (inputs[i] == n);
+		}
+
+		zassert_equal(get_input(rising, n), expected, "input %zu", n);
+		zassert_equal(get_input(changed, n), expected, "input %zu", n);
+		zassert_equal(get_input(falling, n), 0, "input %zu", n);
+		zassert_equal(edge_detect_level(&raw, n), expected,
+			      "input %zu", n);
+	}
+
+	/* Steady input, no edges */
+	zassert_false(update(&raw));
+
+	set_input(33U, 0);
+	zassert_true(update(&raw));
+	zassert_equal(get_input(falling, 33U), 1);
+	zassert_equal(get_input(rising, 33U), 0);
+	zassert_equal(get_input(falling, 0U), 0);
+}
+
+ZTEST(edge_detect, test_optional_masks)
+{
+	set_input(5U, 1);
+	zassert_true(edge_detect_update(&raw, sample, NULL, NULL, NULL));
+	zassert_equal(edge_detect_level(&raw, 5U), 1);
+}
+
+ZTEST(edge_detect, test_majority_rejects_glitch)
+{
+	/* Single sample glitch is filtered */
+	set_input(40U, 1);
+	zassert_false(update(&majority));
+	set_input(40U, 0);
+	zassert_false(update(&majority));
+	zassert_false(update(&majority));
+
+	/* Two out of three samples high */
+	set_input(40U, 1);
+	zassert_false(update(&majority));
+	zassert_true(update(&majority));
+	zassert_equal(get_input(rising, 40U), 1);
+	zassert_equal(edge_detect_level(&majority, 40U), 1);
+}
+
+ZTEST(edge_detect, test_hysteresis)
+{
+	static const int seq[] = {1, 1, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0};
+	static const int level[] = {0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 0, 0};
+
+	for (size_t i = 0U; i < ARRAY_SIZE(seq); i++) {
+		set_input(NUM_INPUTS - 1U, seq[i]);
+		(void)update(&hysteresis);
+
+		zassert_equal(edge_detect_level(&hysteresis, NUM_INPUTS - 1U),
+			      level[i], "sample %zu", i);
+		zassert_equal(get_input(changed, NUM_INPUTS - 1U),
+			      (i > 0U) && (level[i] != level[i - 1U]),
+			      "sample %zu", i);
+	}
+}
+
+ZTEST(edge_detect, test_reset_initial)
+{
+	memset(sample, 0xff, sizeof(sample));
+	edge_detect_reset(&majority, sample);
+
+	/* No edge while inputs stay at the initial level */
+	zassert_false(update(&majority));
+
+	memset(sample, 0, sizeof(sample));
+	zassert_false(update(&majority));
+	zassert_true(update(&majority));
+	zassert_equal(get_input(falling, 0U), 1);
+	zassert_equal(get_input(falling, NUM_INPUTS - 1U), 1);
+}
+
+static void edge_detect_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(sample, 0, sizeof(sample));
+	edge_detect_reset(&raw, NULL);
+	edge_detect_reset(&majority, NULL);
+	edge_detect_reset(&hysteresis, NULL);
+}
+
+ZTEST_SUITE(edge_detect, NULL, NULL, edge_detect_before, NULL, NULL);
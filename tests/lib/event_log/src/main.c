@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test event log library
+ *
+ * This suite logs events to littlefs on the simulated flash, reads them back
+ * by boot and time range, and checks uptime wrapping, persistence across a
+ * remount, file rotation and drop accounting. It also reports the write
+ * amplification of the log, from the flash simulator statistics, next to the
+ * one of appending each event to a file on its own.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/littlefs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/stats/stats.h>
+#include <zephyr/ztest.h>
+
+#include <app/lib/event_log.h>
+
+#define LOG_DIR "/lfs"
+
+#define NUM_FILES  CONFIG_EVENT_LOG_NUM_FILES
+#define FILE_PAGES CONFIG_EVENT_LOG_FILE_PAGES
+
+#define NUM_EVENTS     100U
+#define EVENT_START_MS 1000U
+#define EVENT_STEP_MS  10U
+
+/* Lets the write thread run before both RAM pages are full */
+#define EVENTS_PER_YIELD 8U
+
+/* Enough for all the events kept in the files with large pages */
+#define COLLECT_MAX 4096U
+
+FS_FSTAB_DECLARE_ENTRY(DT_NODELABEL(lfs));
+
+struct flash_usage {
+	uint32_t bytes_written;
+	uint32_t erase_calls;
+};
+
+struct collector {
+	struct event_log_event events[COLLECT_MAX];
+	size_t count;
+	size_t limit;
+};
+
+static struct collector collected;
+
+/* Event i of a test sequence */
+static void event_make(struct event_log_event *event, uint32_t i)
+{
+	event->uptime_ms = EVENT_START_MS + i * EVENT_STEP_MS;
+	event->id = i % 3U;
+	event->type = (i & 1U) ? EVENT_LOG_PERIOD : EVENT_LOG_EDGE;
+	/* Negative values check the zigzag encoding */
+	event->value = (i & 1U) ? (int32_t)(i * 100U) : -(int32_t)i;
+}
+
+static void events_add(uint32_t first, uint32_t count)
+{
+	struct event_log_event event;
+
+	for (uint32_t i = first; i < first + count; i++) {
+		event_make(&event, i);
+		zassert_ok(event_log_add(&event), "event %u", i);
+
+		if ((i % EVENTS_PER_YIELD) == 0U) {
+			k_msleep(1);
+		}
+	}
+}
+
+static bool collect_cb(const struct event_log_event *event, void *user_data)
+{
+	struct collector *c = user_data;
+
+	if (c->count < ARRAY_SIZE(c->events)) {
+		c->events[c->count] = *event;
+	}
+	c->count++;
+
+	return (c->limit == 0U) || (c->count < c->limit);
+}
+
+static int query_boot(uint16_t boot, uint32_t from_ms, uint32_t to_ms,
+		      size_t limit)
+{
+	collected.count = 0U;
+	collected.limit = limit;
+
+	return event_log_query(boot, from_ms, to_ms, collect_cb, &collected);
+}
+
+static int query(uint32_t from_ms, uint32_t to_ms, size_t limit)
+{
+	return query_boot(event_log_boot(), from_ms, to_ms, limit);
+}
+
+static void assert_events(size_t pos, uint32_t first, uint32_t count)
+{
+	struct event_log_event expected;
+
+	for (uint32_t i = 0U; i < count; i++) {
+		const struct event_log_event *event = &collected.events[pos + i];
+
+		event_make(&expected, first + i);
+		zassert_equal(event->uptime_ms, expected.uptime_ms, "event %u",
+			      first + i);
+		zassert_equal(event->id, expected.id);
+		zassert_equal(event->type, expected.type);
+		zassert_equal(event->value, expected.value);
+	}
+}
+
+static int flash_stat_cb(struct stats_hdr *hdr, void *arg, const char *name,
+			 uint16_t off)
+{
+	struct flash_usage *usage = arg;
+	uint32_t val = *(uint32_t *)((uint8_t *)hdr + off);
+
+	if (strcmp(name, "bytes_written") == 0) {
+		usage->bytes_written = val;
+	} else if (strcmp(name, "flash_erase_calls") == 0) {
+		usage->erase_calls = val;
+	}
+
+	return 0;
+}
+
+static void flash_usage_get(struct flash_usage *usage)
+{
+	struct stats_hdr *hdr = stats_group_find("flash_sim_stats");
+
+	zassert_not_null(hdr);
+	zassert_ok(stats_walk(hdr, flash_stat_cb, usage));
+}
+
+ZTEST(event_log, test_query)
+{
+	int ret;
+
+	events_add(0U, NUM_EVENTS);
+
+	/* Events both in files and in RAM, oldest first */
+	ret = query(0U, UINT32_MAX, 0U);
+	zassert_equal(ret, NUM_EVENTS);
+	assert_events(0U, 0U, NUM_EVENTS);
+
+	/* Bounds are inclusive */
+	ret = query(EVENT_START_MS + 20U * EVENT_STEP_MS,
+		    EVENT_START_MS + 59U * EVENT_STEP_MS, 0U);
+	zassert_equal(ret, 40);
+	assert_events(0U, 20U, 40U);
+
+	ret = query(EVENT_START_MS + 20U * EVENT_STEP_MS + 1U,
+		    EVENT_START_MS + 59U * EVENT_STEP_MS - 1U, 0U);
+	zassert_equal(ret, 38);
+	assert_events(0U, 21U, 38U);
+
+	/* Stopped by the callback */
+	ret = query(0U, UINT32_MAX, 3U);
+	zassert_equal(ret, 3);
+	assert_events(0U, 0U, 3U);
+
+	ret = query(0U, EVENT_START_MS - 1U, 0U);
+	zassert_equal(ret, 0);
+}
+
+ZTEST(event_log, test_invalid)
+{
+	struct event_log_event event;
+
+	event_make(&event, 10U);
+	zassert_ok(event_log_add(&event));
+
+	/* Timestamps must not go backwards */
+	event_make(&event, 9U);
+	zassert_equal(event_log_add(&event), -EINVAL);
+
+	event_make(&event, 11U);
+	event.type = EVENT_LOG_PERIOD + 1U;
+	zassert_equal(event_log_add(&event), -EINVAL);
+
+	zassert_equal(query(0U, UINT32_MAX, 0U), 1);
+}
+
+ZTEST(event_log, test_uptime_wrap)
+{
+	static const uint32_t uptimes[] = {
+		UINT32_MAX - 20U, UINT32_MAX - 5U, UINT32_MAX, 4U, 30U,
+	};
+	struct event_log_event event;
+
+	for (size_t i = 0U; i < ARRAY_SIZE(uptimes); i++) {
+		event_make(&event, i);
+		event.uptime_ms = uptimes[i];
+		zassert_ok(event_log_add(&event), "event %u", i);
+	}
+
+	/* Still not allowed to go backwards after the wrap */
+	event_make(&event, 0U);
+	event.uptime_ms = UINT32_MAX;
+	zassert_equal(event_log_add(&event), -EINVAL);
+
+	zassert_equal(query(0U, UINT32_MAX, 0U), ARRAY_SIZE(uptimes));
+	for (size_t i = 0U; i < ARRAY_SIZE(uptimes); i++) {
+		zassert_equal(collected.events[i].uptime_ms, uptimes[i],
+			      "event %u", i);
+	}
+
+	/* In range again after events past its end */
+	zassert_equal(query(0U, 10U, 0U), 1);
+	zassert_equal(collected.events[0].uptime_ms, 4U);
+
+	zassert_equal(query(UINT32_MAX - 10U, UINT32_MAX, 0U), 2);
+	zassert_equal(collected.events[0].uptime_ms, UINT32_MAX - 5U);
+	zassert_equal(collected.events[1].uptime_ms, UINT32_MAX);
+}
+
+ZTEST(event_log, test_persistence)
+{
+	struct fs_mount_t *mp = &FS_FSTAB_ENTRY(DT_NODELABEL(lfs));
+	struct event_log_stats stats;
+	uint16_t boot = event_log_boot();
+
+	events_add(0U, NUM_EVENTS);
+	zassert_ok(event_log_sync());
+
+	/* The partial page is written again in place as it fills up */
+	events_add(NUM_EVENTS, 5U);
+	zassert_ok(event_log_sync());
+
+	event_log_stats_get(&stats);
+	zassert_equal(stats.events, NUM_EVENTS + 5U);
+	zassert_equal(stats.dropped, 0U);
+
+	/* As after a reset */
+	zassert_ok(fs_unmount(mp));
+	zassert_ok(fs_mount(mp));
+	zassert_ok(event_log_init(LOG_DIR));
+	zassert_equal(event_log_boot(), boot + 1U);
+
+	zassert_equal(query_boot(boot, 0U, UINT32_MAX, 0U), NUM_EVENTS + 5U);
+	assert_events(0U, 0U, NUM_EVENTS + 5U);
+	zassert_equal(query(0U, UINT32_MAX, 0U), 0);
+
+	/* Uptimes restart after a reset, new events overlap the old ones */
+	events_add(0U, NUM_EVENTS);
+	zassert_ok(event_log_sync());
+
+	zassert_equal(query(0U, UINT32_MAX, 0U), NUM_EVENTS);
+	assert_events(0U, 0U, NUM_EVENTS);
+
+	/* Old pages straddling the end of the range do not end the query */
+	zassert_equal(query(0U, EVENT_START_MS + 49U * EVENT_STEP_MS, 0U), 50);
+	assert_events(0U, 0U, 50U);
+
+	zassert_equal(query_boot(boot, EVENT_START_MS + 50U * EVENT_STEP_MS,
+				 UINT32_MAX, 0U),
+		      NUM_EVENTS - 45U);
+	assert_events(0U, 50U, NUM_EVENTS - 45U);
+}
+
+ZTEST(event_log, test_rotation)
+{
+	struct event_log_stats stats;
+	struct event_log_event last;
+	struct fs_dirent entry;
+	uint32_t total = 0U;
+	uint32_t first;
+	char path[32];
+	int ret;
+
+	/* Fill the files more than twice */
+	do {
+		events_add(total, EVENTS_PER_YIELD);
+		total += EVENTS_PER_YIELD;
+		event_log_stats_get(&stats);
+	} while (stats.pages_written < 2U * NUM_FILES * FILE_PAGES);
+
+	zassert_ok(event_log_sync());
+	zassert_equal(stats.dropped, 0U);
+
+	/* Only the most recent events are kept, without gaps */
+	ret = query(0U, UINT32_MAX, 0U);
+	zassert_true(ret > 0);
+	zassert_true((uint32_t)ret < total);
+	zassert_true((uint32_t)ret <= COLLECT_MAX, "collector too small");
+
+	first = total - (uint32_t)ret;
+	assert_events(0U, first, (uint32_t)ret);
+
+	event_make(&last, total - 1U);
+	zassert_equal(collected.events[ret - 1].uptime_ms, last.uptime_ms);
+
+	/* No more files than configured */
+	snprintf(path, sizeof(path), LOG_DIR "/log%u", NUM_FILES);
+	zassert_equal(fs_stat(path, &entry), -ENOENT);
+}
+
+ZTEST(event_log, test_dropped)
+{
+	struct event_log_event event;
+	struct event_log_stats stats;
+	uint32_t i = 0U;
+	int ret;
+
+	/* Keep the write thread from running while both pages fill up */
+	k_sched_lock();
+	do {
+		event_make(&event, i++);
+		ret = event_log_add(&event);
+	} while (ret == 0);
+	zassert_equal(ret, -ENOBUFS);
+
+	event_make(&event, i++);
+	zassert_equal(event_log_add(&event), -ENOBUFS);
+	k_sched_unlock();
+
+	event_log_stats_get(&stats);
+	zassert_equal(stats.dropped, 2U);
+	zassert_equal(stats.events, i - 2U);
+
+	/* Logging resumes once a page is written */
+	k_msleep(10);
+	event_make(&event, i++);
+	zassert_ok(event_log_add(&event));
+
+	zassert_equal(query(0U, UINT32_MAX, 0U), i - 2U);
+}
+
+ZTEST(event_log, test_write_amplification)
+{
+	const uint32_t raw = NUM_EVENTS * sizeof(struct event_log_event);
+	struct flash_usage before, after;
+	struct event_log_event event;
+	struct event_log_stats stats;
+	struct fs_file_t file;
+	uint32_t batched;
+	uint32_t single;
+
+	flash_usage_get(&before);
+	events_add(0U, NUM_EVENTS);
+	zassert_ok(event_log_sync());
+	flash_usage_get(&after);
+	batched = after.bytes_written - before.bytes_written;
+
+	event_log_stats_get(&stats);
+	TC_PRINT("event log: %u events, %u bytes raw, %u bytes encoded, "
+		 "%u pages, %u bytes to files\n",
+		 stats.events, raw, stats.encoded_bytes, stats.pages_written,
+		 stats.bytes_written);
+	TC_PRINT("event log: %u bytes and %u erases on flash, "
+		 "write amplification x%u.%02u\n",
+		 batched, after.erase_calls - before.erase_calls,
+		 batched / raw, (batched % raw) * 100U / raw);
+
+	/* Whole pages only: one write per page, not per event */
+	zassert_true(stats.pages_written * 4U < stats.events);
+
+	/* The same events, each appended to a file on its own */
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, LOG_DIR "/single", FS_O_CREATE | FS_O_WRITE));
+	flash_usage_get(&before);
+	for (uint32_t i = 0U; i < NUM_EVENTS; i++) {
+		event_make(&event, i);
+		zassert_equal(fs_write(&file, &event, sizeof(event)),
+			      sizeof(event));
+		zassert_ok(fs_sync(&file));
+	}
+	flash_usage_get(&after);
+	zassert_ok(fs_close(&file));
+	zassert_ok(fs_unlink(LOG_DIR "/single"));
+	single = after.bytes_written - before.bytes_written;
+
+	TC_PRINT("one write per event: %u bytes and %u erases on flash, "
+		 "write amplification x%u.%02u\n",
+		 single, after.erase_calls - before.erase_calls,
+		 single / raw, (single % raw) * 100U / raw);
+
+	zassert_true(batched < single);
+}
+
+static void event_log_before(void *fixture)
+{
+	char path[32];
+
+	ARG_UNUSED(fixture);
+
+	for (unsigned int i = 0U; i <= NUM_FILES; i++) {
+		snprintf(path, sizeof(path), LOG_DIR "/log%u", i);
+		(void)fs_unlink(path);
+	}
+
+	zassert_ok(event_log_init(LOG_DIR));
+}
+
+ZTEST_SUITE(event_log, NULL, NULL, event_log_before, NULL, NULL);
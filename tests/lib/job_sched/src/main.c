@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test job_sched library
+ *
+ * This suite verifies job periods and earliest-deadline-first ordering, and
+ * compares the number of wakeups needed by the application periodic work
+ * (100 ms sampling, 250 ms LED update, 1 s telemetry) when run from one
+ * k_sleep() loop per activity, and from the scheduler with and without
+ * slack.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/ztest.h>
+
+#include <app/lib/job_sched.h>
+
+#define RUN_MS 2000U
+
+#define LOOP_STACK_SIZE 512
+
+struct test_job {
+	struct job_sched_job job;
+	char name;
+};
+
+static char order[8];
+static size_t order_len;
+
+static void record_handler(struct job_sched_job *job)
+{
+	struct test_job *tj = CONTAINER_OF(job, struct test_job, job);
+
+	if (order_len < ARRAY_SIZE(order)) {
+		order[order_len++] = tj->name;
+	}
+}
+
+static void count_handler(struct job_sched_job *job)
+{
+	ARG_UNUSED(job);
+}
+
+static void stop_handler(struct job_sched_job *job)
+{
+	ARG_UNUSED(job);
+
+	job_sched_stop();
+}
+
+static struct job_sched_job stop_job =
+	JOB_SCHED_JOB_INITIALIZER(stop_handler, 0, 0);
+
+/* Run the scheduler for run_ms and return the number of wakeups */
+static uint32_t run_for(uint32_t run_ms)
+{
+	struct job_sched_stats before, after;
+
+	job_sched_stats_get(&before);
+
+	zassert_ok(job_sched_add(&stop_job, run_ms));
+	job_sched_run();
+
+	job_sched_stats_get(&after);
+
+	return after.wakeups - before.wakeups;
+}
+
+ZTEST(job_sched, test_period)
+{
+	struct job_sched_job job;
+
+	job_sched_job_init(&job, count_handler, 10U, 0U);
+	zassert_ok(job_sched_add(&job, 0U));
+	zassert_equal(job_sched_add(&job, 0U), -EALREADY);
+
+	(void)run_for(105U);
+
+	zassert_ok(job_sched_remove(&job));
+	zassert_equal(job_sched_remove(&job), -EALREADY);
+
+	zassert_within(job.runs, 11U, 1U, "%u runs", job.runs);
+	zassert_equal(job.overruns, 0U);
+}
+
+ZTEST(job_sched, test_edf_order)
+{
+	struct test_job a = {.name = 'a'};
+	struct test_job b = {.name = 'b'};
+	struct test_job c = {.name = 'c'};
+
+	/* All due at the same time, with different deadlines */
+	job_sched_job_init(&a.job, record_handler, 0U, 30U);
+	job_sched_job_init(&b.job, record_handler, 0U, 10U);
+	job_sched_job_init(&c.job, record_handler, 0U, 20U);
+
+	order_len = 0U;
+	zassert_ok(job_sched_add(&a.job, 5U));
+	zassert_ok(job_sched_add(&b.job, 5U));
+	zassert_ok(job_sched_add(&c.job, 5U));
+
+	(void)run_for(50U);
+
+	zassert_equal(order_len, 3U);
+	zassert_mem_equal(order, "bca", 3U);
+}
+
+ZTEST(job_sched, test_overrun)
+{
+	struct job_sched_job job;
+
+	job_sched_job_init(&job, count_handler, 10U, 0U);
+	zassert_ok(job_sched_add(&job, 0U));
+
+	/* Nobody runs the scheduler for a while */
+	k_msleep(55);
+
+	(void)run_for(1U);
+	zassert_ok(job_sched_remove(&job));
+
+	zassert_equal(job.runs, 1U, "%u runs", job.runs);
+	zassert_true(job.overruns >= 5U, "%u overruns", job.overruns);
+}
+
+static atomic_t loop_wakeups;
+
+static void sleep_loop(void *p1, void *p2, void *p3)
+{
+	uint32_t period_ms = POINTER_TO_UINT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_msleep(period_ms);
+		atomic_inc(&loop_wakeups);
+	}
+}
+
+K_THREAD_DEFINE(sample_loop_tid, LOOP_STACK_SIZE, sleep_loop,
+		UINT_TO_POINTER(100), NULL, NULL, K_PRIO_PREEMPT(1), 0,
+		SYS_FOREVER_MS);
+K_THREAD_DEFINE(led_loop_tid, LOOP_STACK_SIZE, sleep_loop, UINT_TO_POINTER(250),
+		NULL, NULL, K_PRIO_PREEMPT(1), 0, SYS_FOREVER_MS);
+K_THREAD_DEFINE(telemetry_loop_tid, LOOP_STACK_SIZE, sleep_loop,
+		UINT_TO_POINTER(1000), NULL, NULL, K_PRIO_PREEMPT(1), 0,
+		SYS_FOREVER_MS);
+
+static uint32_t sched_wakeups(uint32_t slack_ms)
+{
+	struct job_sched_job sample, led, telemetry;
+	uint32_t wakeups;
+
+	/* Sampling keeps its exact period, the other jobs may be late */
+	job_sched_job_init(&sample, count_handler, 100U, 0U);
+	job_sched_job_init(&led, count_handler, 250U, slack_ms);
+	job_sched_job_init(&telemetry, count_handler, 1000U, slack_ms);
+
+	/* Start of a tick, so that all jobs get the same phase */
+	k_sleep(K_TICKS(1));
+
+	zassert_ok(job_sched_add(&sample, 100U));
+	zassert_ok(job_sched_add(&led, 250U));
+	zassert_ok(job_sched_add(&telemetry, 1000U));
+
+	wakeups = run_for(RUN_MS);
+
+	zassert_ok(job_sched_remove(&sample));
+	zassert_ok(job_sched_remove(&led));
+	zassert_ok(job_sched_remove(&telemetry));
+
+	/* Slack must not cost runs */
+	zassert_within(sample.runs, RUN_MS / 100U, 1U);
+	zassert_within(led.runs, RUN_MS / 250U, 1U);
+	zassert_within(telemetry.runs, RUN_MS / 1000U, 1U);
+
+	return wakeups;
+}
+
+ZTEST(job_sched, test_wakeups)
+{
+	uint32_t loops, strict, slack;
+
+	/* Before: one k_sleep() loop per activity */
+	atomic_clear(&loop_wakeups);
+	k_thread_start(sample_loop_tid);
+	k_thread_start(led_loop_tid);
+	k_thread_start(telemetry_loop_tid);
+	k_msleep(RUN_MS);
+	k_thread_abort(sample_loop_tid);
+	k_thread_abort(led_loop_tid);
+	k_thread_abort(telemetry_loop_tid);
+	loops = (uint32_t)atomic_get(&loop_wakeups);
+
+	/* After: one thread, with and without slack */
+	strict = sched_wakeups(0U);
+	slack = sched_wakeups(50U);
+
+	TC_PRINT("wakeups/s: sleep loops %u, scheduler %u, with slack %u\n",
+		 loops * 1000U / RUN_MS, strict * 1000U / RUN_MS,
+		 slack * 1000U / RUN_MS);
+
+	/* Jobs due at the same time share a wakeup */
+	zassert_true(strict < loops, "%u >= %u", strict, loops);
+	/* 250 ms jobs wait for the next 100 ms one */
+	zassert_true(slack < strict, "%u >= %u", slack, strict);
+}
+
+ZTEST_SUITE(job_sched, NULL, NULL, NULL, NULL, NULL);
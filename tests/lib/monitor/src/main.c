@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test monitor library
+ *
+ * This suite verifies that the monitor library reports consistent per-thread
+ * CPU shares and stack usage for a thread with a known load.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+#include <app/lib/monitor.h>
+
+/* The busy thread runs for half of each cycle */
+#define BUSY_US 10000U
+#define BUSY_MS 10U
+
+static K_SEM_DEFINE(report_sem, 0, 1);
+static uint8_t report[sizeof(struct monitor_record_header) +
+		      CONFIG_MONITOR_MAX_THREADS *
+			      sizeof(struct monitor_record_thread)];
+static size_t report_len;
+
+static void busy(void *p1, void *p2, void *p3)
+{
+	while (true) {
+		k_busy_wait(BUSY_US);
+		k_msleep(BUSY_MS);
+	}
+}
+
+K_THREAD_DEFINE(busy_tid, 512, busy, NULL, NULL, NULL, K_PRIO_PREEMPT(5), 0,
+		0);
+
+static void on_report(const void *record, size_t len, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (k_sem_count_get(&report_sem) == 0U) {
+		memcpy(report, record, len);
+		report_len = len;
+		k_sem_give(&report_sem);
+	}
+}
+
+ZTEST(monitor, test_report)
+{
+	const struct monitor_record_header *hdr = (const void *)report;
+	const struct monitor_record_thread *threads = (const void *)(hdr + 1);
+	uint32_t total = 0U;
+	bool found = false;
+
+	k_thread_name_set(busy_tid, "busy");
+
+	zassert_ok(monitor_start(on_report, NULL));
+	zassert_equal(monitor_start(on_report, NULL), -EALREADY);
+
+	zassert_ok(k_sem_take(&report_sem,
+			      K_MSEC(2 * CONFIG_MONITOR_PERIOD_MS)));
+	monitor_stop();
+
+	zassert_true(sys_le16_to_cpu(hdr->idle_permille) <= 1000U);
+	zassert_true(hdr->num_threads > 0U, "no threads reported");
+	zassert_equal(report_len, sizeof(*hdr) +
+		      hdr->num_threads * sizeof(*threads));
+
+	for (uint8_t i = 0; i < hdr->num_threads; i++) {
+		uint16_t cpu = sys_le16_to_cpu(threads[i].cpu_permille);
+
+		zassert_true(sys_le16_to_cpu(threads[i].stack_used) <=
+			     sys_le16_to_cpu(threads[i].stack_size));
+		total += cpu;
+
+		if (strncmp(threads[i].name, "busy", sizeof(threads[i].name)) ==
+		    0) {
+			found = true;
+			zassert_within(cpu, 500U, 150U,
+				       "busy thread share %u", cpu);
+		}
+	}
+
+	zassert_true(found, "busy thread not reported");
+	/* The idle thread is reported as well, so shares cover the period */
+	zassert_within(total, 1000U, 100U, "shares do not add up (%u)", total);
+}
+
+ZTEST_SUITE(monitor, NULL, NULL, NULL, NULL, NULL);
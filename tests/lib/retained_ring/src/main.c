@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test retained ring library
+ *
+ * This suite records entries, simulates warm reboots by validating the ring
+ * again, and checks that the entries of previous boots are read back in
+ * order, including once the ring wrapped around. It also measures the cost
+ * of recording an entry, CRC included, over several turns of the ring.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/ztest.h>
+
+#include <app/lib/retained_ring.h>
+
+#define RING_LEN CONFIG_RETAINED_RING_LEN
+
+/* Several times around the ring */
+#define NUM_ITERATIONS (8U * RING_LEN)
+
+struct collector {
+	struct retained_ring_entry entries[RING_LEN];
+	size_t count;
+};
+
+static struct collector collected;
+
+static void collect_cb(const struct retained_ring_entry *entry,
+		       void *user_data)
+{
+	struct collector *c = user_data;
+
+	zassert_true(c->count < ARRAY_SIZE(c->entries));
+	c->entries[c->count++] = *entry;
+}
+
+static int collect(void)
+{
+	collected.count = 0U;
+
+	return retained_ring_foreach_previous(collect_cb, &collected);
+}
+
+/* Entry i of a test sequence */
+static void record(uint32_t i)
+{
+	retained_ring_record(i % 3U, i, -(int32_t)i);
+}
+
+static void assert_entries(uint32_t first, uint32_t count)
+{
+	zassert_equal(collected.count, count);
+
+	for (uint32_t i = 0U; i < count; i++) {
+		const struct retained_ring_entry *entry = &collected.entries[i];
+
+		zassert_equal(entry->type, (first + i) % 3U, "entry %u", i);
+		zassert_equal(entry->id, first + i);
+		zassert_equal(entry->value, -(int32_t)(first + i));
+
+		if (i > 0U) {
+			zassert_equal(entry->seq, entry[-1].seq + 1U);
+		}
+	}
+}
+
+ZTEST(retained_ring, test_empty)
+{
+	zassert_equal(retained_ring_boots(), 0U);
+	zassert_equal(collect(), 0);
+
+	/* Entries of the current boot are not reported */
+	record(0U);
+	zassert_equal(collect(), 0);
+}
+
+ZTEST(retained_ring, test_warm_boot)
+{
+	for (uint32_t i = 0U; i < 5U; i++) {
+		record(i);
+	}
+
+	zassert_equal(retained_ring_init(), 5);
+	zassert_equal(retained_ring_boots(), 1U);
+	zassert_equal(collect(), 5);
+	assert_entries(0U, 5U);
+
+	/* New entries follow, and are reported after the next boot */
+	for (uint32_t i = 5U; i < 8U; i++) {
+		record(i);
+	}
+	zassert_equal(collect(), 5);
+
+	zassert_equal(retained_ring_init(), 8);
+	zassert_equal(retained_ring_boots(), 2U);
+	zassert_equal(collect(), 8);
+	assert_entries(0U, 8U);
+}
+
+ZTEST(retained_ring, test_wraparound)
+{
+	for (uint32_t i = 0U; i < RING_LEN + 5U; i++) {
+		record(i);
+	}
+
+	zassert_equal(retained_ring_init(), RING_LEN);
+	zassert_equal(collect(), RING_LEN);
+	assert_entries(5U, RING_LEN);
+
+	/* Entries of previous boots are overwritten oldest first */
+	for (uint32_t i = 0U; i < 3U; i++) {
+		record(RING_LEN + 5U + i);
+	}
+	zassert_equal(collect(), RING_LEN - 3U);
+	assert_entries(8U, RING_LEN - 3U);
+}
+
+ZTEST(retained_ring, test_clear)
+{
+	record(0U);
+	zassert_equal(retained_ring_init(), 1);
+
+	retained_ring_clear();
+	zassert_equal(retained_ring_boots(), 0U);
+	zassert_equal(collect(), 0);
+
+	zassert_equal(retained_ring_init(), 0);
+}
+
+ZTEST(retained_ring, test_record_cost)
+{
+	timing_t start, end;
+	uint64_t cycles;
+
+	timing_init();
+	timing_start();
+
+	/* Wraps around several times, a single measurement leaves out the
+	 * timer read cost
+	 */
+	start = timing_counter_get();
+	for (uint32_t i = 0U; i < NUM_ITERATIONS; i++) {
+		record(i);
+	}
+	end = timing_counter_get();
+	cycles = timing_cycles_get(&start, &end);
+
+	timing_stop();
+
+	TC_PRINT("per entry: %u cycles, %u entries over a %u entry ring\n",
+		 (uint32_t)(cycles / NUM_ITERATIONS), NUM_ITERATIONS,
+		 (uint32_t)RING_LEN);
+
+	/* All the measured records were stored */
+	zassert_equal(retained_ring_init(), RING_LEN);
+	zassert_equal(collect(), RING_LEN);
+	assert_entries(NUM_ITERATIONS - RING_LEN, RING_LEN);
+}
+
+static void *retained_ring_setup(void)
+{
+	(void)retained_ring_init();
+
+	return NULL;
+}
+
+static void retained_ring_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Start each test as after a power-on reset */
+	retained_ring_clear();
+}
+
+ZTEST_SUITE(retained_ring, NULL, retained_ring_setup, retained_ring_before,
+	    NULL, NULL);
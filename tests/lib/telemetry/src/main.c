@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file test telemetry library
+ *
+ * This suite records telemetry, captures the frames sent on an emulated
+ * UART, decodes them with zcbor and checks their contents, batching and
+ * drop accounting. It also compares the cost of recording an edge with the
+ * cost of formatting the equivalent text line.
+ */
+
+#include <stdio.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/serial/uart_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/ztest.h>
+
+#include <zcbor_decode.h>
+
+#include <app/lib/telemetry.h>
+
+#define BATCH_SIZE CONFIG_TELEMETRY_BATCH_SIZE
+#define QUEUE_LEN  CONFIG_TELEMETRY_QUEUE_LEN
+
+#define NUM_ITERATIONS 100U
+
+static const struct device *const uart =
+	DEVICE_DT_GET(DT_CHOSEN(app_telemetry_uart));
+
+struct decoded_record {
+	uint32_t type;
+	uint32_t delta_ms;
+	uint32_t id;
+	int32_t values[CONFIG_TELEMETRY_MAX_VALUES];
+	size_t num_values;
+};
+
+struct decoded_batch {
+	uint32_t seq;
+	uint32_t base_ms;
+	uint32_t dropped;
+	struct decoded_record records[BATCH_SIZE];
+	size_t num_records;
+};
+
+static uint8_t tx_data[1024];
+static size_t tx_len;
+static size_t tx_pos;
+
+static void tx_capture(void)
+{
+	k_msleep(CONFIG_TELEMETRY_FLUSH_MS / 10U + 10U);
+
+	tx_len += uart_emul_get_tx_data(uart, &tx_data[tx_len],
+					sizeof(tx_data) - tx_len);
+}
+
+/* Decode the next captured frame */
+static void frame_decode(struct decoded_batch *batch)
+{
+	const uint8_t *frame = &tx_data[tx_pos];
+	struct decoded_record *rec;
+	uint16_t len;
+
+	zassert_true(tx_len - tx_pos >= 3U, "no frame");
+	zassert_equal(frame[0], TELEMETRY_FRAME_MAGIC);
+	len = sys_get_le16(&frame[1]);
+	zassert_true(tx_len - tx_pos >= 3U + len, "truncated frame");
+
+	ZCBOR_STATE_D(state, 3, &frame[3], len, 1, 0);
+
+	zassert_true(zcbor_list_start_decode(state));
+	zassert_true(zcbor_uint32_decode(state, &batch->seq));
+	zassert_true(zcbor_uint32_decode(state, &batch->base_ms));
+	zassert_true(zcbor_uint32_decode(state, &batch->dropped));
+	zassert_true(zcbor_list_start_decode(state));
+
+	batch->num_records = 0U;
+	while (!zcbor_array_at_end(state)) {
+		zassert_true(batch->num_records < ARRAY_SIZE(batch->records));
+		rec = &batch->records[batch->num_records++];
+
+		zassert_true(zcbor_list_start_decode(state));
+		zassert_true(zcbor_uint32_decode(state, &rec->type));
+		zassert_true(zcbor_uint32_decode(state, &rec->delta_ms));
+		zassert_true(zcbor_uint32_decode(state, &rec->id));
+
+		rec->num_values = 0U;
+		while (!zcbor_array_at_end(state)) {
+			zassert_true(rec->num_values < ARRAY_SIZE(rec->values));
+			zassert_true(zcbor_int32_decode(
+				state, &rec->values[rec->num_values++]));
+		}
+		zassert_true(zcbor_list_end_decode(state));
+	}
+
+	zassert_true(zcbor_list_end_decode(state));
+	zassert_true(zcbor_list_end_decode(state));
+	zassert_equal(state->payload, &frame[3 + len], "trailing bytes");
+
+	tx_pos += 3U + len;
+}
+
+static void assert_record(const struct decoded_record *rec, uint32_t type,
+			  uint32_t id, int32_t value)
+{
+	zassert_equal(rec->type, type);
+	zassert_equal(rec->id, id);
+	zassert_equal(rec->num_values, 1U);
+	zassert_equal(rec->values[0], value);
+}
+
+ZTEST(telemetry, test_records)
+{
+	const int32_t stats[] = {42, -1, 100000};
+	struct decoded_batch batch;
+
+	zassert_ok(telemetry_edge(3U, true));
+	zassert_ok(telemetry_period(3U, 900U));
+	zassert_ok(telemetry_stats(7U, stats, ARRAY_SIZE(stats)));
+	zassert_equal(telemetry_stats(7U, stats,
+				      CONFIG_TELEMETRY_MAX_VALUES + 1U),
+		      -EINVAL);
+
+	telemetry_flush();
+	tx_capture();
+
+	frame_decode(&batch);
+	zassert_equal(tx_pos, tx_len, "more than one frame");
+
+	zassert_equal(batch.dropped, 0U);
+	zassert_equal(batch.num_records, 3U);
+	assert_record(&batch.records[0], TELEMETRY_TYPE_EDGE, 3U, 1);
+	assert_record(&batch.records[1], TELEMETRY_TYPE_PERIOD, 3U, 900);
+
+	zassert_equal(batch.records[2].type, TELEMETRY_TYPE_STATS);
+	zassert_equal(batch.records[2].id, 7U);
+	zassert_equal(batch.records[2].num_values, ARRAY_SIZE(stats));
+	zassert_mem_equal(batch.records[2].values, stats, sizeof(stats));
+}
+
+ZTEST(telemetry, test_batching)
+{
+	struct decoded_batch batch;
+	uint32_t seq;
+
+	/* Below a full batch, nothing is sent before the batching delay */
+	for (uint16_t i = 0U; i < BATCH_SIZE - 1U; i++) {
+		zassert_ok(telemetry_edge(i, true));
+	}
+	k_msleep(1);
+	zassert_equal(uart_emul_get_tx_data(uart, tx_data, sizeof(tx_data)),
+		      0U);
+
+	/* A full batch is sent right away */
+	zassert_ok(telemetry_edge(BATCH_SIZE - 1U, true));
+	tx_capture();
+
+	frame_decode(&batch);
+	zassert_equal(batch.num_records, BATCH_SIZE);
+	for (uint16_t i = 0U; i < BATCH_SIZE; i++) {
+		assert_record(&batch.records[i], TELEMETRY_TYPE_EDGE, i, 1);
+	}
+	seq = batch.seq;
+
+	/* Lone records wait for the batching delay */
+	zassert_ok(telemetry_edge(0U, false));
+	k_msleep(CONFIG_TELEMETRY_FLUSH_MS);
+	tx_capture();
+
+	frame_decode(&batch);
+	zassert_equal(batch.seq, seq + 1U);
+	zassert_equal(batch.num_records, 1U);
+	assert_record(&batch.records[0], TELEMETRY_TYPE_EDGE, 0U, 0);
+}
+
+ZTEST(telemetry, test_dropped)
+{
+	struct decoded_batch batch;
+	size_t received = 0U;
+	size_t frames = 0U;
+
+	/* Keep the flush work from running while the queue overflows */
+	k_sched_lock();
+	for (uint16_t i = 0U; i < QUEUE_LEN; i++) {
+		zassert_ok(telemetry_period(i, 100U));
+	}
+	zassert_equal(telemetry_period(0U, 100U), -ENOBUFS);
+	zassert_equal(telemetry_period(0U, 100U), -ENOBUFS);
+	k_sched_unlock();
+
+	tx_capture();
+	telemetry_flush();
+	tx_capture();
+
+	while (tx_pos < tx_len) {
+		frame_decode(&batch);
+		zassert_equal(batch.dropped, (frames == 0U) ? 2U : 0U);
+		received += batch.num_records;
+		frames++;
+	}
+
+	zassert_equal(received, QUEUE_LEN);
+}
+
+ZTEST(telemetry, test_record_cost)
+{
+	char line[64];
+	uint64_t record_cycles = 0U;
+	uint64_t format_cycles = 0U;
+	timing_t start, end;
+
+	timing_init();
+	timing_start();
+
+	for (uint32_t i = 0U; i < NUM_ITERATIONS; i++) {
+		start = timing_counter_get();
+		(void)telemetry_edge(1U, (i & 1U) != 0U);
+		end = timing_counter_get();
+		record_cycles += timing_cycles_get(&start, &end);
+
+		start = timing_counter_get();
+		(void)snprintf(line, sizeof(line),
+			       "Proximity detected on pair %u, period %u ms\n",
+			       1U, 100U * i);
+		end = timing_counter_get();
+		format_cycles += timing_cycles_get(&start, &end);
+	}
+
+	timing_stop();
+
+	TC_PRINT("per record: %u cycles, text formatting: %u cycles\n",
+		 (uint32_t)(record_cycles / NUM_ITERATIONS),
+		 (uint32_t)(format_cycles / NUM_ITERATIONS));
+
+	/* Let the batches go before the next test */
+	telemetry_flush();
+	k_msleep(CONFIG_TELEMETRY_FLUSH_MS);
+}
+
+static void telemetry_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	telemetry_flush();
+	k_msleep(CONFIG_TELEMETRY_FLUSH_MS);
+	uart_emul_flush_tx_data(uart);
+
+	tx_len = 0U;
+	tx_pos = 0U;
+}
+
+ZTEST_SUITE(telemetry, NULL, NULL, telemetry_before, NULL, NULL);